@@ -0,0 +1,991 @@
+//A Game of Hex, with an AI using Monte Carlo simulations
+//Author: Omar Safwat
+//Date: 8th of February, 2021
+//The board, the rules and the AI, shared by the game and its benchmarks
+#ifndef A_GAME_OF_HEX_H
+#define A_GAME_OF_HEX_H
+
+#include<iostream>
+#include<iterator>
+#include<vector>
+#include<string>
+#include<utility>   //For pair<>
+#include<algorithm>
+#include<random>
+#include<ctime>    
+#include<unordered_map>
+#include "../Graph-Library/instrumentation.h"
+using namespace std;
+
+const unsigned short SIZE = 11;
+const unsigned short NSIM = 1000;
+//Playouts shared by all the candidate moves of the AMAF AI
+const unsigned short AMAF_NSIM = 10000;
+//Average playouts per candidate move of the racing AI, the last ones left get several times NSIM
+const unsigned short RACE_NSIM = 250;
+//Random seed for the move by the program
+inline default_random_engine e(time(nullptr));
+inline uniform_int_distribution<int> distribution(0, SIZE - 1);
+//The AIs solve the game exactly once this few hexes are left empty, 0 turns the solver off
+inline unsigned short solveEmpty = 12;
+//The AIs skip the dead and captured hexes, and only answer a threat to win on the next move
+inline bool pruneCells = true;
+//The six neighbours of a hex in order around it. Each row is shifted half a hex right of the one above it.
+const short HEX_RING[6][2] = {{-1, 0}, {-1, 1}, {0, 1}, {1, 0}, {1, -1}, {0, -1}};
+
+//Define the board
+class Board
+{
+    public:
+    Board() : board(SIZE, vector<char>(SIZE, '.')), emptyHex(SIZE*SIZE) 
+    {
+        for(unsigned short i = 0; i < emptyHex.size(); i++)
+            emptyHex[i] = i;
+    }
+
+    //Method to place a stone on the board, the player's blue one by default
+    void placeStone (unsigned short input_row, unsigned short input_col, char player = 'B') {board[input_row - 1][input_col - 1] = player;}
+    //Get stone value occupying a certain position
+    char stoneValue (unsigned short input_row, unsigned short input_col) {return board[input_row - 1][input_col - 1];}
+    //Display board
+    void display ();
+    //The up to six hexes next to a hex, both as row * SIZE + col
+    vector<unsigned short> neighbours (unsigned short hex);
+    //Stone at a hex, or the owner of the edge beyond the board: Red the top and bottom, Blue the
+    //sides. 'x' beyond a corner, which is next to both edges.
+    char owner (short row, short col);
+
+    //Check to see if new stone is on one of the four corners
+    bool isTopRight (unsigned short input_row, unsigned short input_col) {return (input_row == 1 && input_col == SIZE) ? true : false;}
+    bool isTopleft (unsigned short input_row, unsigned short input_col) {return (input_row == 1 && input_col == 1) ? true : false;}
+    bool isLowRight (unsigned short input_row, unsigned short input_col) {return (input_row == SIZE && input_col == SIZE) ? true : false;}
+    bool isLowleft (unsigned short input_row, unsigned short input_col) {return (input_row == SIZE && input_col == 1) ? true : false;}
+    //Check for which edge
+    bool isTopEdge (unsigned short input_row) {return (input_row == 1) ? true : false;}
+    bool isLowEdge (unsigned short input_row) {return (input_row == SIZE) ? true : false;}
+    bool isRightEdge (unsigned short input_col) {return (input_col == SIZE) ? true : false;}
+    bool isLeftEdge (unsigned short input_col) {return (input_col == 1) ? true : false;}
+    bool isSideEdge (unsigned short input_col) {return (isLeftEdge(input_col) == true || isRightEdge(input_col) == true) ? true : false;}
+    bool isTop_Low (unsigned short input_row) {return (isTopEdge(input_row) == true || isLowEdge(input_row) == true) ? true : false;}
+
+    protected:
+    //board: '.' for empty hex, 'B' for Blue hex, 'R' for Red hex
+    vector<vector<char>> board;
+    //Vector keeps track of locations of empty hexes on the board. 
+    vector<unsigned short> emptyHex;
+};
+
+//A Disjoint "union find" set routine
+class DisjSet : public Board
+{
+    public:
+    //Create a set of n items "Number of Hexes available on the board" 
+    DisjSet() : Board(), treeSize(SIZE * SIZE), parent(SIZE * SIZE) {makeSet();}
+
+    //create a tree for each hex on the board
+    void makeSet()
+    {
+        for (unsigned short i = 0; i < parent.size(); i++)
+        {
+            parent[i] = i;
+            treeSize[i] = 1;
+        }
+    }
+    unsigned short findSet(unsigned short v)
+    {
+        INSTRUMENT_COUNT(FIND_CALLS);
+        if (v == parent[v])
+            return v;  
+        return parent[v] = findSet(parent[v]);
+    }
+    void unionSets(unsigned short adj, unsigned short newNode);
+
+    protected:
+    vector<unsigned short> treeSize, parent;
+};
+
+//CLass to manange the game
+class HexGame : public DisjSet
+{
+    public:
+    HexGame() : DisjSet() {}
+    //A copy constructor
+    HexGame(const HexGame& game1) : DisjSet()
+    {
+        this -> board = game1.board;
+        this -> parent = game1.parent;
+        this -> emptyHex = game1.emptyHex;
+        this -> treeSize = game1.treeSize;
+        this -> parent = game1.parent;
+    }
+    HexGame& operator=(const HexGame& game1) = default;
+    //Connect adjacet stones to form a bridge
+    void connectStones (unsigned short input_row, unsigned short input_col);
+    //Check if either player won
+    char is_won (unsigned short input_row, unsigned short input_col, char player);
+    //The AIs add the random playouts they ran to played unless it is null. Proven wins and
+    //pruned moves need fewer than their budget, down to none.
+    unsigned short AI (HexGame& game, unsigned long long* played = nullptr);
+    //AI scoring every candidate with the same playouts, "all moves as first"
+    unsigned short AMAF (HexGame& game, unsigned short playouts = AMAF_NSIM, unsigned long long* played = nullptr);
+    //AI racing the candidates, the worse half is dropped after every round of playouts
+    unsigned short Race (HexGame& game, unsigned short playouts = RACE_NSIM, unsigned long long* played = nullptr);
+    //Exact search of the whole game tree, true if Red to move can force a win, with a winning move
+    bool Solve (HexGame& game, unsigned short& winningMove);
+    //Erase filled hexes from vector emptyHex
+    void eraseFilled (unsigned short input_row, unsigned short input_col)
+    {
+        unsigned short i = input_row - 1, j = input_col - 1;
+        //Find the location of the new placed hex in emptyHex
+        pair<vector<unsigned short>::iterator, vector<unsigned short>::iterator> sub_range = equal_range(emptyHex.begin(), emptyHex.end(), i * SIZE + j);
+        //Remove the new filled position from emptyHex vector
+        emptyHex.erase(sub_range.first);
+    }
+
+    private:
+    //Solved positions by their key, true if the player to move wins
+    typedef unordered_map<unsigned long long, bool> SolvedTable;
+    bool solve (char player, unsigned long long key, SolvedTable& table, unsigned short& winningMove);
+    //Whether player's stones join player's two edges, counting the empty hexes as player's too if
+    //throughEmpty: extra stones never hurt in Hex, so otherwise player can't win any more
+    bool joinsEdges (char player, bool throughEmpty);
+    //Solve for the AIs, only once solveEmpty or fewer hexes are left
+    bool provenWin (HexGame& game, unsigned short& winningMove);
+    //Plays count random playouts after Red takes fixHex and returns how many of them Red won
+    unsigned simulate (HexGame& game, unsigned short fixHex, unsigned count);
+    //One playout from the stones and DisjSet of start: cells get the stones in simulations,
+    //in order, and are emptied again once the winner is known. True if Red won.
+    bool randomFill (const HexGame& start, const vector<unsigned short>& cells, const vector<char>& simulations);
+    //Plays the AI's move on the board of game
+    unsigned short playRed (HexGame& game, unsigned short bestMove);
+    //Whether player wins at once by taking hex
+    bool winsAt (unsigned short hex, char player);
+    //Whether an empty hex can't change who wins, whoever takes it
+    bool isDead (unsigned short hex);
+    //Whether Red or Blue has every neighbour of an empty hex but the other one, 'n' if neither
+    char capturedBy (unsigned short hex, unsigned short other);
+    //A copy of game without the empty hexes that can't matter, and the moves left for Red
+    HexGame pruned (HexGame& game, vector<unsigned short>& candidates);
+};
+
+inline void DisjSet::unionSets(unsigned short adj, unsigned short newNode)
+{
+    INSTRUMENT_COUNT(UNION_CALLS);
+    //Map them back to rows and columns With a +1
+    unsigned short new_row = newNode / SIZE;
+    unsigned short new_col = newNode - new_row * SIZE;
+    char player = board[new_row++][new_col++];
+
+    //Find parents of each node
+    unsigned short root_adj = findSet(adj);
+    unsigned short root_adjRow = root_adj / SIZE;
+    unsigned short root_adjCol = (root_adj - root_adjRow++ * SIZE) + 1;
+    
+    unsigned short root_new = findSet(newNode);
+    unsigned short root_newRow = root_new / SIZE;
+    unsigned short root_newCol = (root_new - root_newRow++ * SIZE) + 1; 
+    
+    //cout << "adj_row: " << adj_row << "\nadj_col: " << adj_col << "\nnew_row" << new_row << "\nnew_col" << new_col << "newNode: " << newNode << "\nisLeftEdge: " << isLeftEdge(new_col) << "\nnotSideEdge: " << notSideEdge(root_adjCol); 
+    //A hex on the edge has priority of being the parent
+    //If newNode is Blue, on either of the left or right edges, it should be the parent
+    if(player == 'B' && isSideEdge(root_newCol) == true && isSideEdge(root_adjCol) == false) 
+    {
+        parent[root_adj] = root_new; 
+        //cout << "Parent" <<"[" << root_adj << "]: " << root_new << endl;
+        treeSize[root_new] += treeSize[root_adj]; 
+        return;
+    }
+    //If adj node was Blue and on either left or right edges, it should be the parent
+    if(player == 'B' && isSideEdge(root_adjCol) == true && isSideEdge(root_newCol) == false) 
+    {
+        parent[root_new] = root_adj; 
+        //cout << "Parent" <<"[" << root_new << "]: " << root_adj << endl;
+        treeSize[root_adj] += treeSize[root_new]; 
+        return;
+    }
+   
+    //If newNode is Red, on either of Top or bottom edges, it should be the parent
+    if(player == 'R' && isTop_Low(root_newRow) == true && isTop_Low(root_adjRow) == false) 
+    {
+        parent[root_adj] = root_new; 
+        //cout << "Parent" <<"[" << root_adj << "]: " << root_new << endl;
+        treeSize[root_new] += treeSize[root_adj]; 
+        return;
+    }
+    //if adj node is Red on either top or bottom edges, it should be parent
+    if(player == 'R' && isTop_Low(root_adjRow) == true && isTop_Low(root_newRow) == false) 
+    {
+        parent[root_new] = root_adj; 
+        //cout << "Parent" <<"[" << root_new << "]: " << root_adj << endl;
+        treeSize[root_adj] += treeSize[root_new]; 
+        return;
+    }
+    
+    //If none of the above qualifies, join sets according to size
+    if(treeSize[root_adj] < treeSize[root_new])
+    {
+        parent[root_adj] = root_new;
+        treeSize[root_new] += treeSize[root_adj];
+        //cout << "Parent" <<"[" << root_adj << "]: " << root_new << endl;
+    }
+    else
+    {
+        parent[root_new] = root_adj;
+        treeSize[root_adj] += treeSize[root_new];
+        //cout << "Parent" <<"[" << root_new << "]: " << root_adj << endl;
+    }
+}
+
+//Function to print the board to the player
+inline void Board::display ()
+{
+    //Print out numbers of columns for user to validMove
+    unsigned short t = 1;
+    cout << string(6, ' ');
+    for(unsigned short j = 1; j <= 2*SIZE-1; j++)
+    {
+        if(j % 2 == 0)
+        {
+            cout << " ";
+        }
+        else
+        {
+            if(t < SIZE)
+                cout << "C" << "|" << t++;
+            else
+            {
+                cout << "|" << "C" << t++;
+            }
+        }
+    }
+    cout << endl;
+    //Each dot represents the center of a hex. Each dot has 6 edges!
+    //For Each Row of the board 
+    t = 1;
+    for(unsigned short i = 1; i <= 2*SIZE-1; i++)
+    {
+        cout << string(7, ' ');
+        if(i % 2 == 0)
+        {   
+            //For Each Column
+            for(unsigned short j = 1; j <= 2*SIZE-1; j++)
+            {   
+                if(j % 2 == 0)
+                    cout << " / ";
+                else
+                {
+                    cout << "\\";
+                } 
+            }
+        }
+        else
+        {
+            for(unsigned short j = 1; j <= 2*SIZE-1; j++)
+            {
+                if(j % 2 == 0)
+                {
+                    cout << " - ";
+                }
+                else
+                {
+                    char hexValue = board[(i - 1) / 2][(j - 1) / 2];
+                    cout << hexValue;
+                    if(j == 2 * SIZE - 1) {cout << " -R" << t++;}
+                }
+            }
+        }
+        //Shift the columns of each new row.
+        string nspaces(i, ' ');
+        cout << endl << nspaces;
+    }
+}
+
+inline vector<unsigned short> Board::neighbours (unsigned short hex)
+{
+    short row = hex / SIZE, col = hex % SIZE;
+    vector<unsigned short> adjacent;
+    for(unsigned short k = 0; k < 6; k++)
+    {
+        short i = row + HEX_RING[k][0], j = col + HEX_RING[k][1];
+        if(i >= 0 && i < SIZE && j >= 0 && j < SIZE)
+            adjacent.push_back(i * SIZE + j);
+    }
+    return adjacent;
+}
+
+inline char Board::owner (short row, short col)
+{
+    bool offRows = row < 0 || row >= SIZE, offCols = col < 0 || col >= SIZE;
+    if(offRows && offCols)
+        return 'x';
+    if(offRows)
+        return 'R';
+    if(offCols)
+        return 'B';
+    return board[row][col];
+}
+
+//Associate stones on the board of the same colour to make a path with DisjSet.
+inline void HexGame::connectStones (unsigned short input_row, unsigned short input_col)
+{
+    //let (i,j) be the matrix coordinates of the new hex input by the player
+    //subtract an additional 1, because C++ starts index from 0
+    unsigned short i = input_row - 1, j = input_col - 1;
+    char newStone = board[i][j];
+    //Column and row of adjacent hex to connect with.
+    unsigned short row_adj, col_adj;
+    
+    //First check if the node is on one of the corners
+    if(isTopleft(input_row, input_col) == true)
+    {
+        row_adj = i + 1;
+        col_adj = j;
+        if(board[row_adj][col_adj] == newStone)
+            unionSets(row_adj * SIZE + col_adj, i * SIZE + j);
+        row_adj = i;
+        col_adj = j + 1;
+        if(board[row_adj][col_adj] == newStone)
+            unionSets(row_adj * SIZE + col_adj, i * SIZE + j);
+        return;
+    }
+    if(isTopRight(input_row, input_col) == true)
+    {
+        row_adj = i;
+        col_adj = j - 1;
+        if(board[row_adj][col_adj] == newStone)
+            unionSets(row_adj * SIZE + col_adj, i * SIZE + j);
+        row_adj = i + 1;
+        for(col_adj = j - 1; col_adj <= j; col_adj++)
+            if(board[row_adj][col_adj] == newStone)
+                unionSets(row_adj * SIZE + col_adj, i * SIZE + j);
+        return;
+    }
+    if(isLowleft(input_row, input_col) == true)
+    {
+        row_adj = i;
+        col_adj = j + 1;
+        if(board[row_adj][col_adj] == newStone)
+            unionSets(row_adj * SIZE + col_adj, i * SIZE + j);
+        row_adj = i - 1;
+        for(col_adj = j; col_adj <= j + 1; col_adj++)
+            if(board[row_adj][col_adj] == newStone)
+                unionSets(row_adj * SIZE + col_adj, i * SIZE + j);
+        return;
+    }
+    if(isLowRight(input_row, input_col) == true)
+    {
+        row_adj = i - 1;
+        col_adj = j;
+        if(board[row_adj][col_adj] == newStone)
+            unionSets(row_adj * SIZE + col_adj, i * SIZE + j);
+        row_adj = i;
+        col_adj = j - 1;
+        if(board[row_adj][col_adj] == newStone)
+            unionSets(row_adj * SIZE + col_adj, i * SIZE + j);
+        return; 
+    }
+    
+    //If the new stone is at the edges of the board
+    if(isTopEdge(input_row) == true)
+    {
+        row_adj = i;
+        for(col_adj = j - 1; col_adj <= j + 1; col_adj += 2)
+            if(board[row_adj][col_adj] == newStone)
+                unionSets(row_adj * SIZE + col_adj, i * SIZE + j);
+        row_adj = i + 1;
+        for(col_adj = j - 1; col_adj <= j; col_adj++)
+            if(board[row_adj][col_adj] == newStone)
+                unionSets(row_adj * SIZE + col_adj, i * SIZE + j);
+        return;
+    }
+    if(isLowEdge(input_row) == true)
+    {
+        row_adj = i;
+        for(col_adj = j - 1; col_adj <= j + 1; col_adj += 2)
+            if(board[row_adj][col_adj] == newStone)
+                unionSets(row_adj * SIZE + col_adj, i * SIZE + j);
+        row_adj = i - 1;
+        for(col_adj = j; col_adj <= j + 1; col_adj++)
+            if(board[row_adj][col_adj] == newStone)
+                unionSets(row_adj * SIZE + col_adj, i * SIZE + j);
+        return;
+    }
+    //Side edges have the neighbours of a hex in the middle of the board that are on the board.
+    //The diagonal ones are (i-1, j+1) and (i+1, j-1): looking at the other diagonal, as this
+    //used to, split chains along the edges and made is_won and the AI's playouts miss wins.
+    if(isSideEdge(input_col) == true)
+    {
+        row_adj = i - 1;
+        col_adj = j;
+        if(board[row_adj][col_adj] == newStone)
+            unionSets(row_adj * SIZE + col_adj, i * SIZE + j);
+        row_adj = i + 1;
+        col_adj = j;
+        if(board[row_adj][col_adj] == newStone)
+            unionSets(row_adj * SIZE + col_adj, i * SIZE + j);
+        //For Right edge look left, at the same row and the one below
+        if(isRightEdge(input_col) == true)
+        {
+            col_adj = j - 1;
+            for(row_adj = i; row_adj <= i + 1; row_adj++)
+                if(board[row_adj][col_adj] == newStone)
+                    unionSets(row_adj * SIZE + col_adj, i * SIZE + j);
+            return;
+        }
+        //For Left Edge look right, at the row above and the same row
+        else if(isLeftEdge(input_col) == true)
+        {
+            col_adj = j + 1;
+            for(row_adj = i - 1; row_adj <= i; row_adj++)
+                if(board[row_adj][col_adj] == newStone)
+                    unionSets(row_adj * SIZE + col_adj, i * SIZE + j);
+            return;
+        }
+    }
+    
+    //If newStone is in the middle of the board 
+    //adjacent stones can be found in the 2D Matrix board at:
+    //row: i-1, cols: j, j+1
+    for(col_adj = j; col_adj < j + 2; col_adj ++)
+    {
+        row_adj = i - 1;
+        if(board[row_adj][col_adj] == newStone)
+        {
+            unionSets(row_adj * SIZE + col_adj, i * SIZE + j);
+        }
+    }
+    //row: i, cols: j-1, j+1
+    for(col_adj = j - 1 ; col_adj < j + 2; col_adj += 2)
+    {
+        row_adj = i;
+        if(board[row_adj][col_adj] == newStone)
+        {
+            unionSets(row_adj * SIZE + col_adj, i * SIZE + j);
+        }
+    }
+    //row: i+1, cols: j-1, j
+    for(col_adj = j - 1 ; col_adj <j + 1; col_adj++)
+        {
+            row_adj = i + 1;
+            if(board[row_adj][col_adj] == newStone)
+            {
+                unionSets(row_adj * SIZE + col_adj, i * SIZE + j);
+            }
+        }
+}
+
+//Determine if the game is won. Returns with the char of the winner
+inline char HexGame::is_won (unsigned short input_row, unsigned short input_col, char player = 'n')
+{
+    unsigned short i = input_row - 1;
+    unsigned short j = input_col - 1;
+    //If the player is not prespecified, go find it
+    char newStone = (player == 'n') ? board[i][j] : player;
+
+    //If the player is Blue
+    if(newStone == 'B')
+    {
+        //Check parents of all BLUE elements on the left edge
+        for(unsigned short elem = 0; elem < SIZE; elem++)
+        {
+            if(board[elem][0] == 'B')
+            {
+                unsigned short parent = findSet(elem * SIZE);
+                unsigned short parent_row = parent / SIZE;
+                unsigned short parent_col = parent - parent_row * SIZE;
+                //If parent is on the right edge return true
+                if(parent_col == SIZE - 1) {return 'B';}
+            }
+        } 
+        //Check parents of all BLUE elements on the right row                                 
+        for(unsigned short elem = 0; elem < SIZE; elem++)
+        {
+            if(board[elem][SIZE - 1] == 'B')
+            {
+                unsigned short parent = findSet(elem * SIZE + (SIZE - 1));
+                unsigned short parent_row = parent / SIZE;
+                unsigned short parent_col = parent - parent_row * SIZE;
+                //If parent is on the left edge return true
+                if(parent_col == 0) {return 'B';}
+            } 
+        }
+    }
+    //If the player is Red
+    if(newStone == 'R')
+    {   
+        //Check parents of all RED elements in the top row
+        for(unsigned short elem = 0; elem < SIZE; elem++)
+        {
+            if(board[0][elem] == 'R')
+            {
+                unsigned short parent = findSet(elem);
+                unsigned short parent_row = parent / SIZE;
+                //If parent is on the bottom edge return true
+                if(parent_row == SIZE - 1) {return 'R';}
+            }
+        } 
+        //Check parents of all RED elements in the bottom row                                 
+        for(unsigned short elem = 0; elem < SIZE; elem++)
+        {
+            if(board[SIZE - 1][elem] == 'R')
+            {
+                unsigned short parent = findSet((SIZE - 1) * SIZE + elem);
+                unsigned short parent_row = parent / SIZE;
+                //If parent is on the top edge return true
+                if(parent_row == 0) {return 'R';}
+            }
+        }
+    }
+    return 'n';
+}
+
+inline bool HexGame::randomFill (const HexGame& start, const vector<unsigned short>& cells, const vector<char>& simulations)
+{
+    INSTRUMENT_COUNT(PLAYOUTS);
+    //Restore the DisjSet back to the DisjSet of start
+    parent = start.parent;
+    treeSize = start.treeSize;
+    for(unsigned short index = 0; index < cells.size(); index++)
+    {
+        unsigned short row = cells[index] / SIZE;
+        unsigned short col = cells[index] - row * SIZE;
+        //Assign the random move to the empty Hex
+        board[row][col] = simulations[index];
+        connectStones(row + 1, col + 1);
+    }
+    bool won = is_won(2,2, 'R') == 'R';
+    //Clean up the randomly filled positions, connectStones would see their old stones otherwise
+    for(unsigned short index = 0; index < cells.size(); index++)
+        board[cells[index] / SIZE][cells[index] % SIZE] = '.';
+    return won;
+}
+
+inline unsigned HexGame::simulate (HexGame& game, unsigned short fixHex, unsigned count)
+{
+    //A Copy version of the game (With new Board and DisjSet) with the AI's move fixed on fixHex
+    HexGame gameCpy1(game);
+    unsigned short fix_row = fixHex / SIZE;
+    unsigned short fix_col = fixHex - fix_row * SIZE;
+    gameCpy1.board[fix_row][fix_col] = 'R';
+    gameCpy1.connectStones(fix_row + 1, fix_col + 1);
+    //A 2nd Copy of HexGame to be filled at random in every simulation
+    HexGame gameCpy2(gameCpy1);
+
+    //The empty hexes left for the random moves
+    vector<unsigned short> others;
+    for(unsigned short index = 0; index < game.emptyHex.size(); index++)
+        if(game.emptyHex[index] != fixHex)
+            others.push_back(game.emptyHex[index]);
+    //Number of Blue plays remaining, Blue plays next after the fixedValue
+    unsigned short B_plays = (others.size() + 1) / 2;
+    unsigned short R_plays = others.size() - B_plays;
+    //simulations represents the random choices for 'R' and 'B', after being shuffled.
+    vector<char> simulations(B_plays, 'B');
+    simulations.insert(simulations.end(), R_plays, 'R');
+
+    unsigned win = 0;
+    for(unsigned sim = 0; sim < count; sim++)
+    {
+        shuffle(simulations.begin(), simulations.end(), e);
+        if(gameCpy2.randomFill(gameCpy1, others, simulations))
+            win++;
+    }
+    return win;
+}
+
+inline unsigned short HexGame::playRed (HexGame& game, unsigned short bestMove)
+{
+    unsigned short bestMove_row = bestMove / SIZE;
+    unsigned short bestMove_col = bestMove - bestMove_row * SIZE;
+    game.board[bestMove_row][bestMove_col] = 'R';
+    game.eraseFilled(bestMove_row + 1, bestMove_col + 1);
+    game.connectStones(bestMove_row + 1, bestMove_col + 1);
+    return(bestMove);
+}
+
+//Random key of a stone of player on hex, a position's key is the XOR of the keys of its stones
+inline unsigned long long zobristKey (unsigned short hex, char player)
+{
+    static vector<unsigned long long> keys = []()
+    {
+        mt19937_64 engine(SIZE);
+        vector<unsigned long long> k(2 * SIZE * SIZE);
+        for(unsigned short i = 0; i < k.size(); i++)
+            k[i] = engine();
+        return k;
+    }();
+    return keys[2 * hex + (player == 'R')];
+}
+
+//A flood fill from player's first edge, top for Red and left for Blue, looking for the other one
+inline bool HexGame::joinsEdges (char player, bool throughEmpty)
+{
+    vector<bool> seen(SIZE * SIZE, false);
+    vector<unsigned short> stack;
+    for(unsigned short k = 0; k < SIZE; k++)
+    {
+        unsigned short hex = (player == 'R') ? k : k * SIZE;
+        char stone = board[hex / SIZE][hex % SIZE];
+        if(stone == player || (throughEmpty && stone == '.'))
+        {
+            seen[hex] = true;
+            stack.push_back(hex);
+        }
+    }
+    while(!stack.empty())
+    {
+        unsigned short hex = stack.back();
+        stack.pop_back();
+        short row = hex / SIZE, col = hex % SIZE;
+        if(((player == 'R') ? row : col) == SIZE - 1)
+            return true;
+        for(unsigned short k = 0; k < 6; k++)
+        {
+            short i = row + HEX_RING[k][0], j = col + HEX_RING[k][1];
+            if(i < 0 || i >= SIZE || j < 0 || j >= SIZE || seen[i * SIZE + j])
+                continue;
+            char stone = board[i][j];
+            if(stone == player || (throughEmpty && stone == '.'))
+            {
+                seen[i * SIZE + j] = true;
+                stack.push_back(i * SIZE + j);
+            }
+        }
+    }
+    return false;
+}
+
+//Depth first negamax for a game that is only won or lost: a move that leaves the opponent lost
+//is enough, and only a position where every move does so is lost. With no scores there are no
+//alpha-beta bounds, the search is cut by that first winning move, the table of solved positions
+//and the positions player can't win any more. Moves are played and taken back on this board, and
+//wins found by flood fill, since the DisjSet can't undo a union. emptyHex stays as it was at the
+//root, the hexes taken since are skipped.
+inline bool HexGame::solve (char player, unsigned long long key, SolvedTable& table, unsigned short& winningMove)
+{
+    SolvedTable::iterator known = table.find(key);
+    if(known != table.end())
+        return known->second;
+    char opponent = (player == 'R') ? 'B' : 'R';
+    //Cut off the positions decided already, however the hexes left get filled
+    if(!joinsEdges(player, true))
+        return table[key] = false;
+
+    //Play every move, one that wins on the spot ends the search
+    //Moves next to the most stones are tried first, they're the ones deciding a fight
+    vector<pair<unsigned short, unsigned short>> order;
+    for(unsigned short index = 0; index < emptyHex.size(); index++)
+    {
+        unsigned short hex = emptyHex[index];
+        char& cell = board[hex / SIZE][hex % SIZE];
+        if(cell != '.')
+            continue;
+        cell = player;
+        bool won = joinsEdges(player, false);
+        cell = '.';
+        if(won)
+        {
+            winningMove = hex;
+            table[key] = true;
+            return true;
+        }
+        vector<unsigned short> adjacent = neighbours(hex);
+        unsigned short stones = 0;
+        for(unsigned short k = 0; k < adjacent.size(); k++)
+            if(board[adjacent[k] / SIZE][adjacent[k] % SIZE] != '.')
+                stones++;
+        order.push_back(make_pair(stones, hex));
+    }
+    sort(order.rbegin(), order.rend());
+
+    for(unsigned short k = 0; k < order.size(); k++)
+    {
+        unsigned short hex = order[k].second, reply;
+        char& cell = board[hex / SIZE][hex % SIZE];
+        cell = player;
+        bool lost = !solve(opponent, key ^ zobristKey(hex, player), table, reply);
+        cell = '.';
+        if(lost)
+        {
+            winningMove = hex;
+            table[key] = true;
+            return true;
+        }
+    }
+    table[key] = false;
+    return false;
+}
+
+inline bool HexGame::Solve (HexGame& game, unsigned short& winningMove)
+{
+    INSTRUMENT_PHASE("solve");
+    SolvedTable table;
+    //Every move is taken back, game is left as it was
+    return game.solve('R', 0, table, winningMove);
+}
+
+inline bool HexGame::provenWin (HexGame& game, unsigned short& winningMove)
+{
+    return game.emptyHex.size() <= solveEmpty && Solve(game, winningMove);
+}
+
+inline bool HexGame::winsAt (unsigned short hex, char player)
+{
+    HexGame next(*this);
+    unsigned short row = hex / SIZE, col = hex % SIZE;
+    next.board[row][col] = player;
+    next.connectStones(row + 1, col + 1);
+    return next.is_won(row + 1, col + 1, player) == player;
+}
+
+//Four neighbours in a row around the hex of one colour, counting the edges as their owner's
+//stones, are connected without it. The other two are next to each other, so a stone of the
+//other colour on it connects nothing they don't already.
+inline bool HexGame::isDead (unsigned short hex)
+{
+    short row = hex / SIZE, col = hex % SIZE;
+    char ring[6];
+    for(unsigned short k = 0; k < 6; k++)
+        ring[k] = owner(row + HEX_RING[k][0], col + HEX_RING[k][1]);
+    for(unsigned short first = 0; first < 6; first++)
+    {
+        if(ring[first] != 'R' && ring[first] != 'B')
+            continue;
+        unsigned short run = 1;
+        while(run < 4 && ring[(first + run) % 6] == ring[first])
+            run++;
+        if(run == 4)
+            return true;
+    }
+    return false;
+}
+
+//Two empty hexes next to each other, surrounded otherwise by one colour, are captured by it:
+//a stone of the other colour on one is answered on the other and connects nothing
+inline char HexGame::capturedBy (unsigned short hex, unsigned short other)
+{
+    char colour = 'n';
+    unsigned short pair[2] = {hex, other};
+    for(unsigned short p = 0; p < 2; p++)
+    {
+        short row = pair[p] / SIZE, col = pair[p] % SIZE;
+        for(unsigned short k = 0; k < 6; k++)
+        {
+            short i = row + HEX_RING[k][0], j = col + HEX_RING[k][1];
+            if(i * SIZE + j == pair[1 - p] && i >= 0 && i < SIZE && j >= 0 && j < SIZE)
+                continue;
+            char stone = owner(i, j);
+            if(stone != 'R' && stone != 'B')
+                return 'n';
+            if(colour == 'n')
+                colour = stone;
+            else if(stone != colour)
+                return 'n';
+        }
+    }
+    return colour;
+}
+
+//Inferior cell analysis, by local patterns only. Dead hexes are left out of emptyHex, so the
+//playouts don't fill them, and captured pairs are given to their owner, until neither is
+//found any more. A win at once is the only candidate. Otherwise, if Blue threatens to win
+//on its next move, the candidates are the hexes that stop it, else every hex left in emptyHex.
+inline HexGame HexGame::pruned (HexGame& game, vector<unsigned short>& candidates)
+{
+    HexGame reduced(game);
+    if(!pruneCells)
+    {
+        candidates = game.emptyHex;
+        return reduced;
+    }
+    bool changed = true;
+    while(changed)
+    {
+        changed = false;
+        vector<unsigned short> cells = reduced.emptyHex;
+        for(unsigned short index = 0; index < cells.size(); index++)
+        {
+            unsigned short hex = cells[index], row = hex / SIZE, col = hex % SIZE;
+            if(reduced.board[row][col] != '.')
+                continue;
+            if(reduced.isDead(hex))
+            {
+                reduced.eraseFilled(row + 1, col + 1);
+                changed = true;
+                continue;
+            }
+            vector<unsigned short> adjacent = neighbours(hex);
+            for(unsigned short k = 0; k < adjacent.size(); k++)
+            {
+                unsigned short other = adjacent[k];
+                char colour = (reduced.board[other / SIZE][other % SIZE] == '.') ? reduced.capturedBy(hex, other) : 'n';
+                if(colour == 'n')
+                    continue;
+                reduced.placeStone(row + 1, col + 1, colour);
+                reduced.eraseFilled(row + 1, col + 1);
+                reduced.connectStones(row + 1, col + 1);
+                reduced.placeStone(other / SIZE + 1, other % SIZE + 1, colour);
+                reduced.eraseFilled(other / SIZE + 1, other % SIZE + 1);
+                reduced.connectStones(other / SIZE + 1, other % SIZE + 1);
+                changed = true;
+                break;
+            }
+        }
+    }
+
+    //The wins and threats are found after the fill-in, among the hexes still empty: a captured
+    //pair counts as its owner's stones, and a hex filled or dead can't be a move that matters
+    vector<unsigned short> threats;
+    for(unsigned short index = 0; index < reduced.emptyHex.size(); index++)
+    {
+        unsigned short hex = reduced.emptyHex[index];
+        if(reduced.winsAt(hex, 'R'))
+        {
+            candidates.assign(1, hex);
+            return reduced;
+        }
+        if(reduced.winsAt(hex, 'B'))
+            threats.push_back(hex);
+    }
+    candidates = threats.empty() ? reduced.emptyHex : threats;
+    //Nothing left that matters, the game is decided whatever Red plays
+    if(candidates.empty())
+        candidates = game.emptyHex;
+    return reduced;
+}
+
+//AI using Monte Carlo Simulations
+inline unsigned short HexGame::AI (HexGame& game, unsigned long long* played)
+{
+    INSTRUMENT_PHASE("ai_move");
+    //A proven win needs no simulations, a lost position still gets them to make the most of mistakes
+    unsigned short winningMove;
+    if(provenWin(game, winningMove))
+        return playRed(game, winningMove);
+    //The playouts fill only the hexes that can matter, and only the candidates are tried
+    vector<unsigned short> candidates;
+    HexGame reduced = pruned(game, candidates);
+    if(candidates.size() == 1)
+        return playRed(game, candidates[0]);
+    //A pair to store win/lose ratio for every fixed stone move
+    vector<pair<double, unsigned short>> ratio;
+
+    //Perform NSIM simulations for every valid move on the board
+    for(unsigned short validMove = 0; validMove < candidates.size(); validMove++)
+    {
+        unsigned short fixHex = candidates[validMove];
+        unsigned win = simulate(reduced, fixHex, NSIM);
+        ratio.push_back(make_pair(static_cast<double> (win) / NSIM, fixHex)); 
+    }
+    if(played)
+        *played += static_cast<unsigned long long> (NSIM) * candidates.size();
+
+    //Sort the vector in descending order. The node with highest ratio is the first one
+    sort(ratio.rbegin(), ratio.rend());
+    return playRed(game, ratio[0].second);
+}
+
+//AI using all-moves-as-first statistics. Each playout fills the whole board at random and its
+//result counts for every hex Red got in it, as if Red had played there first. One pool of
+//playouts then ranks all the empty hexes, instead of NSIM playouts for each of them.
+inline unsigned short HexGame::AMAF (HexGame& game, unsigned short playouts, unsigned long long* played)
+{
+    INSTRUMENT_PHASE("ai_move");
+    unsigned short winningMove;
+    if(provenWin(game, winningMove))
+        return playRed(game, winningMove);
+    vector<unsigned short> candidates;
+    HexGame reduced = pruned(game, candidates);
+    if(candidates.size() == 1)
+        return playRed(game, candidates[0]);
+    const vector<unsigned short>& cells = reduced.emptyHex;
+    HexGame gameCpy(reduced);
+    //Red plays next, so it gets the extra hex when their number is odd
+    unsigned short B_plays = cells.size() / 2;
+    unsigned short R_plays = cells.size() - B_plays;
+    vector<char> simulations(B_plays, 'B');
+    simulations.insert(simulations.end(), R_plays, 'R');
+    //Number of playouts in which each hex was Red, and how many of those Red won
+    vector<unsigned> redPlays(SIZE * SIZE, 0), redWins(SIZE * SIZE, 0);
+
+    for(unsigned short sim = 0; sim < playouts; sim++)
+    {
+        shuffle(simulations.begin(), simulations.end(), e);
+        bool won = gameCpy.randomFill(reduced, cells, simulations);
+        for(unsigned short index = 0; index < simulations.size(); index++)
+        {
+            if(simulations[index] == 'R')
+            {
+                redPlays[cells[index]]++;
+                if(won)
+                    redWins[cells[index]]++;
+            }
+        }
+    }
+    if(played)
+        *played += playouts;
+
+    //Pick the candidate with the highest win ratio
+    unsigned short bestMove = candidates[0];
+    double bestRatio = -1;
+    for(unsigned short index = 0; index < candidates.size(); index++)
+    {
+        unsigned short hex = candidates[index];
+        double ratio = (redPlays[hex] > 0) ? static_cast<double> (redWins[hex]) / redPlays[hex] : 0;
+        if(ratio > bestRatio)
+        {
+            bestRatio = ratio;
+            bestMove = hex;
+        }
+    }
+    return playRed(game, bestMove);
+}
+
+//AI racing the candidate moves by successive halving. The total of playouts times the number
+//of empty hexes is split evenly between log2(candidates) rounds. Each round shares its part
+//between the candidates left, adds to their wins, and keeps the better half by win ratio so
+//far, until two are left. Hopeless moves stop after a few dozen playouts, the last two get thousands.
+inline unsigned short HexGame::Race (HexGame& game, unsigned short playouts, unsigned long long* played)
+{
+    INSTRUMENT_PHASE("ai_move");
+    unsigned short winningMove;
+    if(provenWin(game, winningMove))
+        return playRed(game, winningMove);
+    vector<unsigned short> candidates;
+    HexGame reduced = pruned(game, candidates);
+    if(candidates.size() == 1)
+        return playRed(game, candidates[0]);
+    size_t budget = static_cast<size_t> (playouts) * candidates.size();
+    unsigned short rounds = 1;
+    while((1u << rounds) < candidates.size())
+        rounds++;
+    //Playouts and wins of every candidate over all the rounds so far
+    vector<unsigned> plays(SIZE * SIZE, 0), wins(SIZE * SIZE, 0);
+    //A pair to store win/lose ratio for every candidate left, the same ranking as AI
+    vector<pair<double, unsigned short>> ratio;
+
+    while(true)
+    {
+        unsigned count = max<size_t>(1, budget / (rounds * candidates.size()));
+        ratio.clear();
+        for(unsigned short index = 0; index < candidates.size(); index++)
+        {
+            unsigned short hex = candidates[index];
+            wins[hex] += simulate(reduced, hex, count);
+            plays[hex] += count;
+            if(played)
+                *played += count;
+            ratio.push_back(make_pair(static_cast<double> (wins[hex]) / plays[hex], hex));
+        }
+        sort(ratio.rbegin(), ratio.rend());
+        if(ratio.size() <= 2)
+            break;
+        //Keep the better half
+        candidates.resize((ratio.size() + 1) / 2);
+        for(unsigned short index = 0; index < candidates.size(); index++)
+            candidates[index] = ratio[index].second;
+    }
+    return playRed(game, ratio[0].second);
+}
+
+#endif
@@ -0,0 +1,104 @@
+//Benchmarks of single source shortest paths on random graphs of growing size, with about ten
+//edges per vertex, for each priority queue of the graph library
+#include <benchmark/benchmark.h>
+#include "../Dijkstra-Algorithm/Dijkstra_list.h"
+
+const double AVERAGE_DEGREE = 10;
+const unsigned SEED = 1;
+
+template <typename Queue>
+static void BM_Dijkstra(benchmark::State &state)
+{
+    int n = state.range(0);
+    Graph<int> g(n, AVERAGE_DEGREE / n, SEED);
+    for (auto _ : state)
+    {
+        ShortestPaths<int> sp = shortest_paths<Queue>(g, 0);
+        benchmark::DoNotOptimize(sp.distance(n - 1));
+    }
+    state.SetComplexityN(n);
+}
+BENCHMARK_TEMPLATE(BM_Dijkstra, PriorityQueue<int, BinaryHeap>)->RangeMultiplier(2)->Range(1 << 10, 1 << 14)->Complexity();
+BENCHMARK_TEMPLATE(BM_Dijkstra, PriorityQueue<int, QuaternaryHeap>)->RangeMultiplier(2)->Range(1 << 10, 1 << 14)->Complexity();
+BENCHMARK_TEMPLATE(BM_Dijkstra, PriorityQueue<int, RadixHeap>)->RangeMultiplier(2)->Range(1 << 10, 1 << 14)->Complexity();
+BENCHMARK_TEMPLATE(BM_Dijkstra, PriorityQueue<int, BucketQueue>)->RangeMultiplier(2)->Range(1 << 10, 1 << 14)->Complexity();
+BENCHMARK_TEMPLATE(BM_Dijkstra, PriorityQueue<int, FibonacciHeap>)->RangeMultiplier(2)->Range(1 << 10, 1 << 14)->Complexity();
+
+//The same search on the compressed rows of the graph instead of its linked lists
+static void BM_DijkstraCsr(benchmark::State &state)
+{
+    int n = state.range(0);
+    Graph<int> lists(n, AVERAGE_DEGREE / n, SEED);
+    CsrGraph<int> g = CsrGraph<int>::from_graph(lists);
+    vector<int> dist, parent;
+    for (auto _ : state)
+    {
+        dijkstra_search<PriorityQueue<int, BucketQueue>>(g, 0, dist, parent);
+        benchmark::DoNotOptimize(dist.data());
+    }
+    state.SetComplexityN(n);
+}
+BENCHMARK(BM_DijkstraCsr)->RangeMultiplier(2)->Range(1 << 10, 1 << 14)->Complexity();
+
+//The same compressed rows written to a file and searched through a memory map, warm in the page cache
+static void BM_DijkstraMapped(benchmark::State &state)
+{
+    int n = state.range(0);
+    Graph<int> lists(n, AVERAGE_DEGREE / n, SEED);
+    string file_name = "dijkstra_benchmark_" + to_string(n) + ".csr";
+    MappedCsrGraph<int> g;
+    if (!write_csr_file<int>(file_name, lists) || !g.open(file_name))
+    {
+        state.SkipWithError("Failed to write the graph file");
+        return;
+    }
+    vector<int> dist, parent;
+    for (auto _ : state)
+    {
+        dijkstra_search<PriorityQueue<int, BucketQueue>>(g, 0, dist, parent);
+        benchmark::DoNotOptimize(dist.data());
+    }
+    state.SetComplexityN(n);
+    g.close();
+    remove(file_name.c_str());
+}
+BENCHMARK(BM_DijkstraMapped)->RangeMultiplier(2)->Range(1 << 10, 1 << 14)->Complexity();
+
+//And on compressed rows with the vertices renumbered, renumbering isn't timed
+template <VertexOrder Order>
+static void BM_DijkstraOrder(benchmark::State &state)
+{
+    int n = state.range(0);
+    Graph<int> lists(n, AVERAGE_DEGREE / n, SEED);
+    Renumbering r(lists, Order);
+    CsrGraph<int> g = r.apply<int>(lists);
+    vector<int> dist, parent;
+    for (auto _ : state)
+    {
+        dijkstra_search<PriorityQueue<int, BucketQueue>>(g, r.to_new(0), dist, parent);
+        benchmark::DoNotOptimize(dist.data());
+    }
+    state.SetComplexityN(n);
+}
+BENCHMARK_TEMPLATE(BM_DijkstraOrder, VertexOrder::Bfs)->RangeMultiplier(2)->Range(1 << 10, 1 << 14)->Complexity();
+BENCHMARK_TEMPLATE(BM_DijkstraOrder, VertexOrder::CuthillMcKee)->RangeMultiplier(2)->Range(1 << 10, 1 << 14)->Complexity();
+BENCHMARK_TEMPLATE(BM_DijkstraOrder, VertexOrder::Degree)->RangeMultiplier(2)->Range(1 << 10, 1 << 14)->Complexity();
+
+//The 32 nearest vertices to a different source each time, on graphs of growing size. A local
+//search resets nothing between queries, so its time shouldn't grow with the graph.
+static void BM_DijkstraNearest(benchmark::State &state)
+{
+    int n = state.range(0);
+    Graph<int> lists(n, AVERAGE_DEGREE / n, SEED);
+    CsrGraph<int> g = CsrGraph<int>::from_graph(lists);
+    LocalSearch<PriorityQueue<int, BucketQueue>, int> local(n);
+    int src = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(local.nearest(g, src, 32).data());
+        src = (src + 7919) % n;
+    }
+}
+BENCHMARK(BM_DijkstraNearest)->RangeMultiplier(4)->Range(1 << 10, 1 << 16);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,159 @@
+//Benchmarks of the Hex AI: latency of one AI move and the random playouts it played per second,
+//on positions with a growing number of stones already on the board
+#include <benchmark/benchmark.h>
+#include "../A Game of Hex/A Game of Hex.h"
+
+bool someone_won(HexGame &game)
+{
+    return game.is_won(1, 1, 'R') == 'R' || game.is_won(1, 1, 'B') == 'B';
+}
+
+//Whether either player has won, or wins at once by taking one of the empty hexes
+bool one_move_from_won(HexGame &game)
+{
+    if (someone_won(game))
+        return true;
+    for (unsigned short row = 1; row <= SIZE; row++)
+        for (unsigned short col = 1; col <= SIZE; col++)
+            for (char player : {'R', 'B'})
+            {
+                if (game.stoneValue(row, col) != '.')
+                    continue;
+                HexGame next(game);
+                next.placeStone(row, col, player);
+                next.connectStones(row, col);
+                if (next.is_won(row, col, player) == player)
+                    return true;
+            }
+    return false;
+}
+
+//Places the given number of stones at random, alternating blue and red, on a fixed seed. A hex
+//after which either player could win with the next stone is skipped, so the game is still open.
+HexGame open_position(int stones)
+{
+    HexGame game;
+    default_random_engine position(stones);
+    vector<unsigned short> cells(SIZE * SIZE);
+    for (unsigned short i = 0; i < cells.size(); i++)
+        cells[i] = i;
+    shuffle(cells.begin(), cells.end(), position);
+    int placed = 0;
+    for (unsigned short i = 0; i < cells.size() && placed < stones; i++)
+    {
+        unsigned short row = cells[i] / SIZE + 1, col = cells[i] % SIZE + 1;
+        char player = (placed % 2 == 0) ? 'B' : 'R';
+        HexGame next(game);
+        next.placeStone(row, col, player);
+        next.eraseFilled(row, col);
+        next.connectStones(row, col);
+        if (one_move_from_won(next))
+            continue;
+        game = next;
+        placed++;
+    }
+    return game;
+}
+
+//Skips the benchmark if game is already won, timing the AIs on it would measure nothing
+bool still_open(benchmark::State &state, HexGame &game)
+{
+    if (someone_won(game))
+    {
+        state.SkipWithError("the position is already won");
+        return false;
+    }
+    return true;
+}
+
+static void BM_HexAI(benchmark::State &state)
+{
+    int stones = state.range(0);
+    HexGame start = open_position(stones);
+    if (!still_open(state, start))
+        return;
+    e.seed(1);
+    unsigned long long played = 0;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        HexGame game(start);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(game.AI(game, &played));
+    }
+    state.counters["playouts/s"] = benchmark::Counter(played, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_HexAI)->Arg(1)->Arg(40)->Arg(80)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+//The AMAF AI, whose AMAF_NSIM playouts are shared by every candidate move
+static void BM_HexAMAF(benchmark::State &state)
+{
+    int stones = state.range(0);
+    HexGame start = open_position(stones);
+    if (!still_open(state, start))
+        return;
+    e.seed(1);
+    unsigned long long played = 0;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        HexGame game(start);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(game.AMAF(game, AMAF_NSIM, &played));
+    }
+    state.counters["playouts/s"] = benchmark::Counter(played, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_HexAMAF)->Arg(1)->Arg(40)->Arg(80)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+//The racing AI, RACE_NSIM playouts per empty hex on average
+static void BM_HexRace(benchmark::State &state)
+{
+    int stones = state.range(0);
+    HexGame start = open_position(stones);
+    if (!still_open(state, start))
+        return;
+    e.seed(1);
+    unsigned long long played = 0;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        HexGame game(start);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(game.Race(game, RACE_NSIM, &played));
+    }
+    state.counters["playouts/s"] = benchmark::Counter(played, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_HexRace)->Arg(1)->Arg(40)->Arg(80)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+//The exact endgame search on its own, with arg empty hexes left
+static void BM_HexSolve(benchmark::State &state)
+{
+    HexGame game = open_position(SIZE * SIZE - state.range(0));
+    if (!still_open(state, game))
+        return;
+    unsigned short move;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(game.Solve(game, move));
+}
+BENCHMARK(BM_HexSolve)->Arg(8)->Arg(12)->Arg(14)->Unit(benchmark::kMillisecond);
+
+//The AMAF AI on a game still open after arg stones, with and without the dead and captured hexes pruned
+static void BM_HexPrune(benchmark::State &state)
+{
+    HexGame start = open_position(state.range(0));
+    if (!still_open(state, start))
+        return;
+    pruneCells = state.range(1);
+    e.seed(1);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        HexGame game(start);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(game.AMAF(game));
+    }
+    pruneCells = true;
+}
+BENCHMARK(BM_HexPrune)->ArgsProduct({{40, 80}, {0, 1}})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
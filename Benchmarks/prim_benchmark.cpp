@@ -0,0 +1,104 @@
+//Benchmarks of the minimum spanning tree algorithms on dense and sparse random graphs
+#include <random>
+#include <benchmark/benchmark.h>
+#include "../Prim's Algorithm/Prim_matrix.h"
+
+const int MAX_WEIGHT = 100;
+const int SPARSE_DEGREE = 8;
+
+//Random undirected graph with every edge listed in both directions, as in the graph files
+vector<EDGE> random_edges(int n, size_t count, unsigned seed)
+{
+    default_random_engine e(seed);
+    uniform_int_distribution<int> vertex(0, n - 1), weight(1, MAX_WEIGHT);
+    vector<EDGE> edges;
+    edges.reserve(2 * count);
+    for (size_t i = 0; i < count; i++)
+    {
+        int u = vertex(e), v = vertex(e), w = weight(e);
+        edges.push_back({u, v, w});
+        edges.push_back({v, u, w});
+    }
+    return edges;
+}
+
+//Half of all vertex pairs
+vector<EDGE> dense_edges(int n) { return random_edges(n, (size_t)n * n / 4, n); }
+vector<EDGE> sparse_edges(int n) { return random_edges(n, (size_t)n * SPARSE_DEGREE / 2, n); }
+
+//The O(V^2) array scan the program uses on dense graphs
+template <typename T>
+static void BM_PrimDense(benchmark::State &state)
+{
+    int n = state.range(0);
+    Graph<T> g(n, dense_edges(n));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(prim_dense(g).tree_cost());
+    state.SetComplexityN(n);
+}
+BENCHMARK_TEMPLATE(BM_PrimDense, int)->RangeMultiplier(2)->Range(1 << 9, 1 << 12)->Unit(benchmark::kMillisecond)->Complexity();
+BENCHMARK_TEMPLATE(BM_PrimDense, uint16_t)->RangeMultiplier(2)->Range(1 << 9, 1 << 12)->Unit(benchmark::kMillisecond)->Complexity();
+
+//prim_algo's search: a heap on the same matrix
+template <typename Queue>
+static void BM_PrimMatrixHeap(benchmark::State &state)
+{
+    int n = state.range(0);
+    Graph<int> g(n, dense_edges(n));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(prim_tree<Queue>(g).tree_cost());
+    state.SetComplexityN(n);
+}
+BENCHMARK_TEMPLATE(BM_PrimMatrixHeap, PriorityQueue<int, BinaryHeap>)->RangeMultiplier(2)->Range(1 << 9, 1 << 12)->Unit(benchmark::kMillisecond)->Complexity();
+BENCHMARK_TEMPLATE(BM_PrimMatrixHeap, PriorityQueue<int, BucketQueue>)->RangeMultiplier(2)->Range(1 << 9, 1 << 12)->Unit(benchmark::kMillisecond)->Complexity();
+
+template <typename Queue>
+static void BM_PrimSparse(benchmark::State &state)
+{
+    int n = state.range(0);
+    SparseGraph g(n, sparse_edges(n));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(prim_sparse<Queue>(g).tree_cost());
+    state.SetComplexityN(n);
+}
+BENCHMARK_TEMPLATE(BM_PrimSparse, PriorityQueue<int, BinaryHeap>)->RangeMultiplier(4)->Range(1 << 12, 1 << 20)->Unit(benchmark::kMillisecond)->Complexity();
+BENCHMARK_TEMPLATE(BM_PrimSparse, PriorityQueue<int, QuaternaryHeap>)->RangeMultiplier(4)->Range(1 << 12, 1 << 20)->Unit(benchmark::kMillisecond)->Complexity();
+BENCHMARK_TEMPLATE(BM_PrimSparse, PriorityQueue<int, BucketQueue>)->RangeMultiplier(4)->Range(1 << 12, 1 << 20)->Unit(benchmark::kMillisecond)->Complexity();
+
+//The 4-ary heap on the sparse graph with its vertices renumbered, renumbering isn't timed
+template <VertexOrder Order>
+static void BM_PrimSparseOrder(benchmark::State &state)
+{
+    int n = state.range(0);
+    SparseGraph input(n, sparse_edges(n));
+    Renumbering r(input, Order);
+    SparseGraph g = r.apply<int>(input);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(prim_sparse(g).tree_cost());
+    state.SetComplexityN(n);
+}
+BENCHMARK_TEMPLATE(BM_PrimSparseOrder, VertexOrder::Bfs)->RangeMultiplier(4)->Range(1 << 12, 1 << 20)->Unit(benchmark::kMillisecond)->Complexity();
+BENCHMARK_TEMPLATE(BM_PrimSparseOrder, VertexOrder::CuthillMcKee)->RangeMultiplier(4)->Range(1 << 12, 1 << 20)->Unit(benchmark::kMillisecond)->Complexity();
+BENCHMARK_TEMPLATE(BM_PrimSparseOrder, VertexOrder::Degree)->RangeMultiplier(4)->Range(1 << 12, 1 << 20)->Unit(benchmark::kMillisecond)->Complexity();
+
+static void BM_Kruskal(benchmark::State &state)
+{
+    int n = state.range(0);
+    vector<EDGE> edges = sparse_edges(n);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(kruskal(n, edges).tree_cost());
+    state.SetComplexityN(n);
+}
+BENCHMARK(BM_Kruskal)->RangeMultiplier(4)->Range(1 << 12, 1 << 20)->Unit(benchmark::kMillisecond)->UseRealTime()->Complexity();
+
+static void BM_Boruvka(benchmark::State &state)
+{
+    int n = state.range(0);
+    vector<EDGE> edges = sparse_edges(n);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(boruvka(n, edges).tree_cost());
+    state.SetComplexityN(n);
+}
+BENCHMARK(BM_Boruvka)->RangeMultiplier(4)->Range(1 << 12, 1 << 20)->Unit(benchmark::kMillisecond)->UseRealTime()->Complexity();
+
+BENCHMARK_MAIN();
@@ -5,284 +5,283 @@
                     Omar Safwat
 */                    
 
-#include <iostream>
-#include <vector>
-#include <ctime>
-#include <random>
-#include <utility>
-#include <cmath>
-using namespace std;
+#include "Dijkstra_list.h"
 
-const double MAX_DIST = 10.0;   //Max edge distance
-const double MIN_DIST = 1.0;
-const int INF_DIST = 12.0;      //Infinite distance
-const int NNODES = 50;          //Default number of Nodes generated per graph
-
-//NODE represents the vertices in graph
-typedef struct NODE 
-{ 
-    int vertex; 
-    int weight;
-    NODE* next;
-}NODE;
-bool operator< (NODE N1, NODE N2) { return (N1.weight < N2.weight ? true : false); }
-
-//Heap sorting functions
-void heapify(vector<NODE> &pq, int size, int root)
-{
-    int smallest = root;
-    int l = 2*root + 1;
-    int r = 2*root + 2;
- 
-    // if left child is smaller than root
-    if (l < size && pq[l] < pq[smallest])
-        smallest = l;
- 
-    // if right child is smaller than smallest so far
-    if (r < size && pq[r] < pq[smallest])
-        smallest = r;
- 
-    if (smallest != root)
-    {
-        swap(pq[root], pq[smallest]);
- 
-        // recursively heapify the affected sub-tree
-        heapify(pq, size, smallest);
-    }
-}
-
-void heapSort(vector<NODE> &pq)
-{
-    int size = pq.size();
-        //Builds a heap (rearrange).
-    for (int root = size / 2 - 1; root >= 0; root--)    
-        heapify(pq, size, root);
-
-    for (int i = size - 1; i > 0; i--)
-    {   
-        //Moves the smallest vertex (At the root, pq[0]) to the end of the array (Bottom right corner of heap).
-        swap(pq[0], pq[i]);
-        //Moves the next smallest vertex to the root, to repeat the above step.
-        heapify (pq, i, 0);
-    }
-}
-
-//Priority Queue using STL vector
-class PriorityQueue
-{
-    public:
-    explicit PriorityQueue (int n = NNODES);
-    void insert (NODE N) {pq.push_back (N);}
-    void sort_queue () {heapSort (pq);}
-    int top () {return pq.back().vertex;}             // returns NODE with top priority
-    void pop_queue () {pq.pop_back();}
-    void chgPriority (int v, int w);
-    void print_queue () 
-    {
-        cout << "My Queue is:\n";
-        for (int i = 0; i < pq.size(); i++)
-            cout << pq[i].weight << "\t\t";
-    }
-    bool is_empty () {return pq.empty ();}
-    private:
-    vector <NODE> pq;
-};
-
-PriorityQueue::PriorityQueue (int n)
-{
-    for (int i = 0; i < n; i++)
-        insert ({i, INF_DIST, NULL});
-}
-void PriorityQueue::chgPriority (int v, int w)
-{
-    int i = 0;
-    //Looks for the element in Queue with this vertex ID.
-    while (pq[i].vertex != v)
-        i++;
-    //Update nodes weight.
-    pq[i].weight = w;    
-}
-
-//Defining class adjacency_list
-class adj_list
+//Runs the requested mode with edge weights of type W and Queue as the priority queue,
+//searching with the vertices renumbered in order
+template <typename W, typename Queue>
+int run (const vector <string> &args, VertexOrder order)
 {
-    public:
-    friend class Graph;
-    adj_list () : head (NULL), tail (NULL) {}
-    void add_edge (int v, int w)
-    {
-        NODE* newNode = new NODE;
-        newNode->vertex = v;
-        newNode->weight = w;
-        newNode->next = NULL;
-        
-        if (head == NULL)
+        string mode = (args.size () > 0) ? args [0] : "";
+        //--bench-ch [nodes] [density] [queries]: hierarchy against plain Dijkstra on a random graph
+        if (mode == "--bench-ch")
         {
-            head = newNode;
-            tail = newNode;
+            int n = (args.size () > 1) ? stoi (args [1]) : 2000;
+            double density = (args.size () > 2) ? stod (args [2]) : 0.002;
+            int queries = (args.size () > 3) ? stoi (args [3]) : 100;
+            benchmark_ch<Queue, W> (n, density, queries);
+            return 0;
         }
-        else
+        //--bench-heaps [nodes] [density] [searches]: every priority queue on the same random graph
+        if (mode == "--bench-heaps")
         {
-            tail->next = newNode;
-            tail = newNode;
-        } 
-    }
-    NODE* get_head () {return head;}
-    void print_list () 
-    {
-        NODE* current = head;
-        while (current != NULL)
+            int n = (args.size () > 1) ? stoi (args [1]) : 10000;
+            double density = (args.size () > 2) ? stod (args [2]) : 0.001;
+            int searches = (args.size () > 3) ? stoi (args [3]) : 10;
+            benchmark_heaps<W> (n, density, searches);
+            return 0;
+        }
+        //--bench-local [nodes] [density] [queries] [k]: k nearest queries, full search against local search
+        if (mode == "--bench-local")
         {
-            cout << current->vertex << "->";
-            current = current->next;
+            int n = (args.size () > 1) ? stoi (args [1]) : 10000;
+            double density = (args.size () > 2) ? stod (args [2]) : 0.001;
+            int queries = (args.size () > 3) ? stoi (args [3]) : 1000;
+            int k = (args.size () > 4) ? stoi (args [4]) : 10;
+            benchmark_local<Queue, W> (n, density, queries, k);
+            return 0;
         }
-    }
-    ~adj_list () 
-    {
-        //cout << "list destructor was invoked";
-        while (head != NULL)
+        //--nearest <k> [nodes] [density] [src] and --within <radius> [nodes] [density] [src]: the k
+        //nearest vertices to src, or those no further than radius, closest first
+        if ((mode == "--nearest" || mode == "--within") && args.size () > 1)
         {
-            NODE* temp = new NODE;
-            temp = head;
-            head = head->next;
-            delete temp;
+            int n = (args.size () > 2) ? stoi (args [2]) : NNODES;
+            double density = (args.size () > 3) ? stod (args [3]) : 0.4;
+            int src = (args.size () > 4) ? stoi (args [4]) : 0;
+            if (src < 0 || src >= n)
+            {
+                cout << "Invalid vertex" << endl;
+                return 1;
+            }
+            Graph<W> g(n, density);
+            LocalSearch<Queue, W> local(n);
+            const vector <int> &found = (mode == "--nearest") ? local.nearest (g, src, stoi (args [1]))
+                                                              : local.within (g, src, (W) stod (args [1]));
+            for (size_t i = 0; i < found.size (); i++)
+                cout << found [i] << "\t" << local.distance (found [i]) << "\n";
+            return 0;
         }
-    }
-    private:
-    NODE* head;
-    NODE* tail;
-};
-
-//Class Graph
-class Graph
-{
-    public:
-    explicit Graph (int n = NNODES);
-    void print_graph ();
-    vector <NODE> get_adjNodes (int vertex);
-   ~Graph () {delete [] adj;}
-
-    private:    
-    adj_list* adj;           //An array (adj) of pointers to linked lists, which store graph's data
-    int size;
-};
-
-Graph::Graph (int n) : size (n)
-{
-    default_random_engine e(time(0));
-    bernoulli_distribution prob (0.4);                  //Graph density factor is 40%
-    uniform_int_distribution <int> d(0, 49);            //distribute edge distances with uniform prob.
-
-    adj = new adj_list [size];                          //Array of list heads for each vertex                                                                  
-    int MAX_edge_num = 0.5* size * (size -1);           //Max number of edges for an undirected graph with size as number of vertices                  
-   
-    for (int j = 0; j < MAX_edge_num / size; j++)
-        //For each adjacency node
-        for (int i = 0; i < size; i++)
+        //--build-ch <file> [nodes] [density]: preprocess a random graph and save its hierarchy
+        if (mode == "--build-ch" && args.size () > 1)
         {
-            //Probability an egde exist
-            bool p = prob (e);
+            int n = (args.size () > 2) ? stoi (args [2]) : NNODES;
+            double density = (args.size () > 3) ? stod (args [3]) : 0.4;
+            Graph<W> g(n, density);
+            ContractionHierarchy<W> ch(g);
+            if (!ch.save (args [1]))
+            {
+                cout << "Failed to write " << args [1] << endl;
+                return 1;
+            }
+            cout << "Saved hierarchy of " << n << " vertices with " << ch.shortcut_count () << " shortcuts\n";
+            return 0;
+        }
+        //--query-ch <file> <src> <dst>: shortest path from a saved hierarchy
+        if (mode == "--query-ch" && args.size () > 3)
+        {
+            ContractionHierarchy<W> ch;
+            int src = stoi (args [2]), dst = stoi (args [3]);
+            if (!ch.load (args [1]) || src < 0 || dst < 0 || src >= ch.get_size () || dst >= ch.get_size ())
+            {
+                cout << "Invalid hierarchy file or vertex" << endl;
+                return 1;
+            }
+            vector <int> p = ch.path (src, dst);
+            if (p.empty ())
+            {
+                cout << dst << " can't be reached from " << src << endl;
+                return 0;
+            }
+            cout << "Distance: " << ch.distance (src, dst) << "\nPath: " << p [0];
+            for (size_t i = 1; i < p.size (); i++)
+                cout << "->" << p [i];
+            cout << endl;
+            return 0;
+        }
 
-            //pick a random vertix and a random edge to connect with vertex i
-            int v = d (e);
-            int w = d (e) % 10 + 1;
+        //--export <file> [nodes] [density] [src]: write every distance and parent instead of
+        //printing the paths. Files ending in .csv are text, anything else is the binary format.
+        if (mode == "--export" && args.size () > 1)
+        {
+            typedef chrono::steady_clock Clock;
+            int n = (args.size () > 2) ? stoi (args [2]) : NNODES;
+            double density = (args.size () > 3) ? stod (args [3]) : 0.4;
+            int src = (args.size () > 4) ? stoi (args [4]) : 0;
+            Graph<W> g(n, density);
+            Clock::time_point start = Clock::now ();
+            ShortestPaths<W> sp = shortest_paths<Queue> (g, src, order);
+            Clock::time_point searched = Clock::now ();
+            const string &file_name = args [1];
+            bool csv = file_name.size () >= 4 && file_name.compare (file_name.size () - 4, 4, ".csv") == 0;
+            if (!(csv ? sp.export_csv (file_name) : sp.save (file_name)))
+            {
+                cout << "Failed to write " << file_name << endl;
+                return 1;
+            }
+            cout << "Search: " << chrono::duration <double, milli> (searched - start).count () << " ms\tExport: "
+                 << chrono::duration <double, milli> (Clock::now () - searched).count () << " ms\n";
+            return 0;
+        }
+        //--path <file> <vertex>: path to one vertex from a result saved by --export
+        if (mode == "--path" && args.size () > 2)
+        {
+            ShortestPaths<W> sp;
+            int v = stoi (args [2]);
+            if (!sp.load (args [1]) || v < 0 || v >= sp.get_size ())
+            {
+                cout << "Invalid result file or vertex" << endl;
+                return 1;
+            }
+            vector <int> p = sp.path (v);
+            if (p.empty ())
+            {
+                cout << v << " can't be reached from " << sp.get_src () << endl;
+                return 0;
+            }
+            cout << "Distance: " << sp.distance (v) << "\nPath: " << p [0];
+            for (size_t i = 1; i < p.size (); i++)
+                cout << "->" << p [i];
+            cout << endl;
+            return 0;
+        }
 
-            //Assign results to adjacency list
-            if (p == true) {adj [i].add_edge (v, w); adj [v].add_edge (i, w);}  
+        //--csr <file> [src] [out] [--check]: search a graph converted by graph_convert straight from
+        //its file. Nothing is parsed or copied, the search pages in only the parts of the graph it
+        //reaches and checks them on the way. --check reads and checks the whole file first instead.
+        //The distances and parents go to out like --export, or just their average is printed.
+        if (mode == "--csr" && args.size () > 1)
+        {
+            vector <string> csr_args;
+            bool check = false;
+            for (size_t i = 0; i < args.size (); i++)
+                if (args [i] == "--check")
+                    check = true;
+                else
+                    csr_args.push_back (args [i]);
+            typedef chrono::steady_clock Clock;
+            Clock::time_point start = Clock::now ();
+            MappedCsrGraph<W> g;
+            int src = (csr_args.size () > 2) ? stoi (csr_args [2]) : 0;
+            if (csr_args.size () < 2 || !g.open (csr_args [1]) || (check && !g.check ()) || src < 0 || src >= g.get_size ())
+            {
+                cout << "Invalid graph file, weight type or vertex" << endl;
+                return 1;
+            }
+            Clock::time_point mapped = Clock::now ();
+            if (order != VertexOrder::Input)
+                cout << "A mapped graph is searched in its own order, renumber it before converting\n";
+            vector <W> dist;
+            vector <int> parent;
+            dijkstra_search<Queue> (g, src, dist, parent);
+            Clock::time_point searched = Clock::now ();
+            if (g.is_corrupt ())
+            {
+                cout << "Invalid graph file, the search reached offsets, targets or weights it can't hold" << endl;
+                return 1;
+            }
+            cout << "Vertices: " << g.get_size () << "\tEdges: " << g.edge_count () << "\nMap: "
+                 << chrono::duration <double, milli> (mapped - start).count () << " ms\tSearch: "
+                 << chrono::duration <double, milli> (searched - mapped).count () << " ms\n";
+            ShortestPaths<W> sp (src, dist, parent);
+            if (csr_args.size () < 4)
+            {
+                cout << "Average Shortest Path is: " << sp.average () << endl;
+                return 0;
+            }
+            const string &file_name = csr_args [3];
+            bool csv = file_name.size () >= 4 && file_name.compare (file_name.size () - 4, 4, ".csv") == 0;
+            if (!(csv ? sp.export_csv (file_name) : sp.save (file_name)))
+            {
+                cout << "Failed to write " << file_name << endl;
+                return 1;
+            }
+            return 0;
         }
-}
 
-void Graph::print_graph ()
-{
-    for (int i = 0; i < size; i++)
-    {
-        cout << i << "->";
-        adj [i].print_list ();
-        cout << endl;
-    }
+        //Graph is generated randomly and shortest path for each vertex is printed out
+        Graph<W> g(NNODES);
+        dijkstra<Queue> (g, 0, NNODES, order);
+        return 0;
 }
 
-vector <NODE> Graph::get_adjNodes (int top)
+//Compiles run once per heap policy and calls the one picked. Without one the fastest queue for
+//max_weight, the largest weight of the graph searched, is used.
+template <typename W>
+int run_with_heap (const vector <string> &args, const string &heap, VertexOrder order, double max_weight)
 {
-    NODE* current = adj [top].get_head ();
-    vector <NODE> adj_nodes;                //Create a Vector to store data of adjacent nodes
-    while (current != NULL)
-    {
-        adj_nodes.push_back ({current->vertex, current->weight, NULL});
-        current = current->next;
-    }
-    return adj_nodes;                       //return the vector to Dijkstra function
+        HeapPolicy policy = fastest_heap<W> ((W) min (max_weight, (double) numeric_limits<W>::max ()), true);
+        if (!heap.empty () && !parse_heap_policy (heap, policy))
+        {
+            cout << "Unknown heap " << heap << ", expected binary, dary, radix, bucket or fibonacci" << endl;
+            return 1;
+        }
+        int status = 0;
+        try
+        {
+            with_heap<W> (policy, [&] (auto tag) {status = run <W, typename decltype (tag)::type> (args, order);});
+        }
+        catch (const length_error &e)
+        {
+            cout << e.what () << endl;
+            return 1;
+        }
+        return status;
 }
 
-void update_adjNodes (Graph &g, PriorityQueue &PQ, int dist [], int parent [])
+//Name of the weight type stored in a compressed rows file, as --weights takes it
+string csr_weight_name (const CsrFileHeader &header)
 {
-    int top = PQ.top ();                                //top is the vertex with top priority (least weight)
-    PQ.pop_queue ();
-    vector <NODE> adjNodes = g.get_adjNodes (top);      //A vector containing the data of neighbouring nodes
-
-    for (int i = 0; i < adjNodes.size (); i++)
-    {   
-        int v = adjNodes [i].vertex;
-        int w = adjNodes [i].weight;
-        //Updating distance values
-        if ((w + dist [top]) < dist [v])
-        {   
-            dist [v] = w + dist [top];
-            parent [v] = top;
-            //cout << parent [v] << endl;
-            PQ.chgPriority (v, w + dist [top]);
-        }
-    }
-    PQ.sort_queue ();
+        if (header.weight_kind == 1)
+            return (header.weight_size == sizeof (double)) ? "double" : "float";
+        return (header.weight_size == sizeof (int64_t)) ? "int64" : "int32";
 }
 
-//Shortest path algorithm
-void dijkstra (Graph &g, int src, int n)   
+int main (int argc, char* argv [])
 {
-    int dist [n];                           //To record min dist from source node
-    int parent [n];                         //Parent array saves the shortest path information
-    PriorityQueue PQ (n);
-    for (int i = 0; i < n; i++) 
-        dist [i] = INF_DIST;    
-
-    dist [src] = 0;
-    parent [src] = 0;
-    while (!PQ.is_empty ())
-        update_adjNodes (g, PQ, dist, parent); 
-    
-    //Calculating average shortest path
-    double avg = 0;
-    for (int i = 0; i < n; i++)
-    {
-        //To check if the node has atleast one edge (connected)
-        if (dist [i] < INF_DIST)
-            avg += (dist [i] - avg) / (i+1);    //A superior calculation to prevent overflow
-    }
-    cout << "Average Shortest Path is: " << avg << "\n\nPrintiong out shortest path of each vertex:\n\n";
-    for (int i = 0; i < n; i++)
-    {
-        cout << i;
-        int v = parent [i];
-        while (v > 0)
+        vector <string> args (argv + 1, argv + argc);
+        //--weights int32|int64|float|double picks the edge weight type, it has to come first.
+        //32 bit weights halve the memory traffic of 64 bit ones, so they are the default.
+        //--heap binary|dary|radix|bucket|fibonacci picks the priority queue, it may come before or
+        //after --weights. Integer weights up to MAX_DIST use the bucket queue by default, floating
+        //point ones the 4-ary heap. --order bfs|rcm|degree renumbers the vertices before the search,
+        //the paths printed or exported still use the generated numbers. --csr takes the weight type
+        //stored in its file unless --weights says otherwise.
+        string weights, heap, order_name = "input";
+        while (args.size () > 1 && (args [0] == "--weights" || args [0] == "--heap" || args [0] == "--order"))
         {
-            cout << "<-" << v;
-            v = parent [v];
+            if (args [0] == "--weights")
+                weights = args [1];
+            else if (args [0] == "--heap")
+                heap = args [1];
+            else
+                order_name = args [1];
+            args.erase (args.begin (), args.begin () + 2);
         }
-        cout << "<-0\n\n";
-    }
-}
-
-int main ()
-{
-        //Graph is generated randomly and shortest path for each vertex is printed out
-        Graph g(50);
-        dijkstra (g, 0, 50);
-        return 0;
+        //Generated graphs have weights up to MAX_DIST, a graph file records its largest one
+        double max_weight = MAX_DIST;
+        CsrFileHeader header;
+        if (args.size () > 1 && args [0] == "--csr" && read_csr_header (args [1], header))
+        {
+            max_weight = header.max_weight;
+            if (weights.empty ())
+                weights = csr_weight_name (header);
+        }
+        if (weights.empty ())
+            weights = "int32";
+        VertexOrder order;
+        if (!parse_vertex_order (order_name, order))
+        {
+            cout << "Unknown vertex order " << order_name << ", expected input, bfs, rcm or degree" << endl;
+            return 1;
+        }
+        if (weights == "int32")
+            return run_with_heap <int32_t> (args, heap, order, max_weight);
+        if (weights == "int64")
+            return run_with_heap <int64_t> (args, heap, order, max_weight);
+        if (weights == "float")
+            return run_with_heap <float> (args, heap, order, max_weight);
+        if (weights == "double")
+            return run_with_heap <double> (args, heap, order, max_weight);
+        cout << "Unknown weight type " << weights << ", expected int32, int64, float or double" << endl;
+        return 1;
 }
-
-
-
-
-
-
-
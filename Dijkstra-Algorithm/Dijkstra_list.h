@@ -0,0 +1,1057 @@
+/*Shortest Path algortihm using Adjacency list representation
+
+                    2nd November 2020
+
+                    Omar Safwat
+*/                    
+
+//Graphs, searches and contraction hierarchies, shared by the program and its benchmarks
+#ifndef DIJKSTRA_LIST_H
+#define DIJKSTRA_LIST_H
+
+#include <iostream>
+#include <vector>
+#include <ctime>
+#include <random>
+#include <utility>
+#include <cmath>
+#include <queue>
+#include <limits>
+#include <fstream>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <charconv>
+#include "../Graph-Library/graph_algorithms.h"
+#include "../Graph-Library/vertex_order.h"
+#include "../Graph-Library/mapped_graph.h"
+#include "../Graph-Library/csv_writer.h"
+using namespace std;
+
+const double MAX_DIST = 10.0;   //Max edge distance
+const double MIN_DIST = 1.0;
+const int NNODES = 50;          //Default number of Nodes generated per graph
+
+//Node of an adjacency list, W is the type of the edge weights.
+//With 32 bit weights a node packs into 16 bytes instead of 24.
+template <typename W>
+struct ADJ_NODE 
+{ 
+    int vertex; 
+    W weight;
+    ADJ_NODE* next;
+};
+
+//Defining class adjacency_list
+template <typename W>
+class adj_list
+{
+    public:
+    template <typename> friend class Graph;
+    adj_list () : head (NULL), tail (NULL) {}
+    void add_edge (int v, W w)
+    {
+        ADJ_NODE<W>* newNode = new ADJ_NODE<W>;
+        newNode->vertex = v;
+        newNode->weight = w;
+        newNode->next = NULL;
+        
+        if (head == NULL)
+        {
+            head = newNode;
+            tail = newNode;
+        }
+        else
+        {
+            tail->next = newNode;
+            tail = newNode;
+        } 
+    }
+    ADJ_NODE<W>* get_head () {return head;}
+    void print_list () 
+    {
+        ADJ_NODE<W>* current = head;
+        while (current != NULL)
+        {
+            cout << current->vertex << "->";
+            current = current->next;
+        }
+    }
+    ~adj_list () 
+    {
+        //cout << "list destructor was invoked";
+        while (head != NULL)
+        {
+            ADJ_NODE<W>* temp = head;
+            head = head->next;
+            delete temp;
+        }
+    }
+    private:
+    ADJ_NODE<W>* head;
+    ADJ_NODE<W>* tail;
+};
+
+//Random edge distance between MIN_DIST and MAX_DIST with uniform prob.
+template <typename W>
+W random_weight (default_random_engine &e)
+{
+    if constexpr (is_floating_point<W>::value)
+        return uniform_real_distribution <W> (MIN_DIST, MAX_DIST) (e);
+    else
+        return uniform_int_distribution <W> (MIN_DIST, MAX_DIST) (e);
+}
+
+//Class Graph
+template <typename W>
+class Graph
+{
+    public:
+    //The same seed generates the same graph, e.g. for benchmarks
+    explicit Graph (int n = NNODES, double density = 0.4, unsigned seed = time (0));
+    void print_graph ();
+    vector <NODE<W>> get_adjNodes (int vertex);
+    int get_size () {return size;}
+    //Calls f(vertex, weight) for each neighbour, without copying them as get_adjNodes does
+    template <typename F>
+    void for_each_edge (int vertex, F f)
+    {
+        for (ADJ_NODE<W>* current = adj [vertex].get_head (); current != NULL; current = current->next)
+            f (current->vertex, current->weight);
+    }
+   ~Graph () {delete [] adj;}
+
+    private:    
+    adj_list<W>* adj;        //An array (adj) of pointers to linked lists, which store graph's data
+    int size;
+};
+
+template <typename W>
+Graph<W>::Graph (int n, double density, unsigned seed) : size (n)
+{
+    INSTRUMENT_PHASE ("generate_graph");
+    default_random_engine e(seed);
+    bernoulli_distribution prob (density);              //Graph density factor, 40% by default
+    uniform_int_distribution <int> d(0, size - 1);      //pick the other end of each edge with uniform prob.
+
+    adj = new adj_list<W> [size];                          //Array of list heads for each vertex                                                                  
+    long long MAX_edge_num = 0.5* size * (size -1);        //Max number of edges for an undirected graph with size as number of vertices                  
+   
+    for (int j = 0; j < MAX_edge_num / size; j++)
+        //For each adjacency node
+        for (int i = 0; i < size; i++)
+        {
+            //Probability an egde exist
+            bool p = prob (e);
+
+            //pick a random vertix and a random edge to connect with vertex i
+            int v = d (e);
+            W w = random_weight<W> (e);
+
+            //Assign results to adjacency list
+            if (p == true) {adj [i].add_edge (v, w); adj [v].add_edge (i, w);}  
+        }
+}
+
+template <typename W>
+void Graph<W>::print_graph ()
+{
+    for (int i = 0; i < size; i++)
+    {
+        cout << i << "->";
+        adj [i].print_list ();
+        cout << endl;
+    }
+}
+
+template <typename W>
+vector <NODE<W>> Graph<W>::get_adjNodes (int top)
+{
+    ADJ_NODE<W>* current = adj [top].get_head ();
+    vector <NODE<W>> adj_nodes;                //Create a Vector to store data of adjacent nodes
+    while (current != NULL)
+    {
+        adj_nodes.push_back ({current->vertex, current->weight});
+        current = current->next;
+    }
+    return adj_nodes;                       //return the vector to Dijkstra function
+}
+
+//Distances and parents found by a single source search. A path is rebuilt only when asked for
+//by following the parents, so storing or exporting the result is linear in the number of vertices.
+template <typename W>
+class ShortestPaths
+{
+    public:
+    ShortestPaths () : src (0) {}
+    ShortestPaths (int s, vector <W> d, vector <int> p) : src (s), dist (d), parent (p) {}
+    int get_size () {return dist.size ();}
+    int get_src () {return src;}
+    W distance (int v) {return dist [v];}
+    bool reachable (int v) {return dist [v] != inf_dist<W> ();}
+    vector <int> path (int v);                      //Vertices from src to v, empty if v can't be reached
+    double average ();
+    bool export_csv (const string &file_name);      //One "vertex,distance,parent" line per vertex
+    bool save (const string &file_name);            //Compact binary copy of dist and parent
+    bool load (const string &file_name);            //False, and empty, for a file that isn't a valid result
+
+    private:
+    int src;
+    vector <W> dist;
+    vector <int> parent;                            //-1 for src and vertices that can't be reached
+};
+
+template <typename W>
+vector <int> ShortestPaths<W>::path (int v)
+{
+    vector <int> result;
+    if (!reachable (v))
+        return result;
+    for (; v != -1; v = parent [v])
+        result.push_back (v);
+    reverse (result.begin (), result.end ());
+    return result;
+}
+
+//Average shortest path over the vertices that can be reached
+template <typename W>
+double ShortestPaths<W>::average ()
+{
+    double avg = 0;
+    int count = 0;
+    for (size_t i = 0; i < dist.size (); i++)
+        if (reachable (i))
+            avg += (dist [i] - avg) / ++count;      //A superior calculation to prevent overflow
+    return avg;
+}
+
+template <typename W>
+bool ShortestPaths<W>::export_csv (const string &file_name)
+{
+    INSTRUMENT_PHASE ("export");
+    CsvWriter out (file_name);
+    if (!out.is_open ())
+        return false;
+    out.text ("vertex,distance,parent\n");
+    for (size_t i = 0; i < dist.size (); i++)
+    {
+        out.field (i);
+        out.text (",");
+        if (reachable (i))
+            out.field (dist [i]);
+        else
+            out.text ("inf");
+        out.text (",");
+        out.field (parent [i]);
+        out.text ("\n");
+    }
+    return out.close ();
+}
+
+//File layout: "SP01", weight size, vertex count, src, dist [size], parent [size]
+template <typename W>
+bool ShortestPaths<W>::save (const string &file_name)
+{
+    INSTRUMENT_PHASE ("export");
+    ofstream out (file_name, ios::binary);
+    if (!out.is_open ())
+        return false;
+    int header [3] = {(int) sizeof (W), (int) dist.size (), src};
+    out.write ("SP01", 4);
+    out.write (reinterpret_cast <const char*> (header), sizeof (header));
+    out.write (reinterpret_cast <const char*> (dist.data ()), dist.size () * sizeof (W));
+    out.write (reinterpret_cast <const char*> (parent.data ()), parent.size () * sizeof (int));
+    return out.good ();
+}
+
+template <typename W>
+bool ShortestPaths<W>::load (const string &file_name)
+{
+    dist.clear ();
+    parent.clear ();
+    ifstream in (file_name, ios::binary | ios::ate);
+    long long length = in.tellg ();
+    in.seekg (0);
+    char magic [4];
+    int header [3];
+    if (!in.read (magic, 4) || string (magic, 4) != "SP01")
+        return false;
+    if (!in.read (reinterpret_cast <char*> (header), sizeof (header)) || header [0] != sizeof (W) || header [1] < 0)
+        return false;
+    //The file must hold exactly the arrays its header announces
+    if (length != 4 + (long long) sizeof (header) + (long long) header [1] * (long long) (sizeof (W) + sizeof (int)))
+        return false;
+    vector <W> d (header [1]);
+    vector <int> p (header [1]);
+    in.read (reinterpret_cast <char*> (d.data ()), d.size () * sizeof (W));
+    in.read (reinterpret_cast <char*> (p.data ()), p.size () * sizeof (int));
+    if (in.fail ())
+        return false;
+    //path () follows the parents of reachable vertices back to src: they must stay inside the
+    //array, not go round in circles and end at src
+    int n = header [1];
+    if (n > 0 && (header [2] < 0 || header [2] >= n || p [header [2]] != -1 || d [header [2]] != 0))
+        return false;
+    if (!is_parent_forest (p))
+        return false;
+    for (int v = 0; v < n; v++)
+    {
+        bool reached = d [v] != inf_dist<W> ();
+        if (p [v] >= 0 ? (!reached || d [p [v]] == inf_dist<W> ()) : (reached && v != header [2]))
+            return false;
+    }
+    src = header [2];
+    dist.swap (d);
+    parent.swap (p);
+    return true;
+}
+
+//Single source shortest paths, returns the distance and parent of every vertex.
+//Queue is any of the priority queues of the graph library. Any order but Input searches a copy
+//of the graph with its vertices renumbered, the results still use the original numbers.
+template <typename Queue, typename W>
+ShortestPaths<W> shortest_paths (Graph<W> &g, int src, VertexOrder order = VertexOrder::Input)
+{
+    vector <W> dist;                        //To record min dist from source node
+    vector <int> parent;                    //Parent array saves the shortest path information
+    if (order == VertexOrder::Input)
+    {
+        dijkstra_search<Queue> (g, src, dist, parent);
+        return ShortestPaths<W> (src, dist, parent);
+    }
+    Renumbering r(g, order, src);
+    CsrGraph<W> renumbered = r.apply<W> (g);
+    dijkstra_search<Queue> (renumbered, r.to_new (src), dist, parent);
+    return ShortestPaths<W> (src, r.restore (dist), r.restore_ids (parent));
+}
+
+//Shortest path algorithm
+template <typename Queue, typename W>
+void dijkstra (Graph<W> &g, int src, int n, VertexOrder order = VertexOrder::Input)
+{
+    ShortestPaths<W> sp = shortest_paths<Queue> (g, src, order);
+    cout << "Average Shortest Path is: " << sp.average () << "\n\nPrintiong out shortest path of each vertex:\n\n";
+    for (int i = 0; i < n; i++)
+    {
+        vector <int> p = sp.path (i);
+        if (p.empty ())
+        {
+            cout << i << " can't be reached\n\n";
+            continue;
+        }
+        cout << i;
+        for (int j = p.size () - 2; j >= 0; j--)
+            cout << "<-" << p [j];
+        cout << "\n\n";
+    }
+}
+
+//Point to point query with the plain algorithm, stops as soon as dst leaves the queue
+template <typename Queue, typename W>
+W dijkstra_query (Graph<W> &g, int src, int dst)
+{
+    vector <W> dist;
+    vector <int> parent;
+    dijkstra_search<Queue> (g, src, dist, parent, dst);
+    return dist [dst];
+}
+
+const int CH_SETTLE_LIMIT = 500;                    //Max vertices settled by one witness search
+const int CH_HOP_LIMIT = 5;                         //Max edges on a witness path
+
+//Edge of the contraction hierarchy
+template <typename W>
+struct CH_EDGE
+{
+    int vertex;
+    W weight;
+    int middle;         //Contracted vertex bypassed by a shortcut, -1 for an edge of the original graph
+};
+
+//Contraction Hierarchy for answering many shortest path queries on the same static graph.
+//Vertices are removed ("contracted") one at a time, least important first. Whenever removing a
+//vertex would break the only shortest path between two of its neighbours, a shortcut edge is added.
+//A query is a bidirectional search that only ever climbs towards more important vertices,
+//so it settles a handful of vertices instead of the whole graph.
+template <typename W>
+class ContractionHierarchy
+{
+    public:
+    ContractionHierarchy () : size (0), shortcuts (0) {}
+    explicit ContractionHierarchy (Graph<W> &g) {build (g);}
+    void build (Graph<W> &g);
+    bool save (const string &file_name);
+    bool load (const string &file_name);            //False, and empty, for a file that isn't a valid hierarchy
+    W distance (int src, int dst);                  //inf_dist if dst can't be reached
+    vector <int> path (int src, int dst);           //Vertices from src to dst, empty if unreachable
+    int get_size () {return size;}
+    int shortcut_count () {return shortcuts;}
+    size_t memory_bytes ();
+
+    private:
+    int query (int src, int dst);                   //Returns the vertex where both searches met, -1 if none
+    int contract (int v);
+    void add_shortcuts ();
+    void witness_search (int src, int skip, W limit);
+    const CH_EDGE<W>* find_edge (int u, int v);
+    void unpack (int u, int v, vector <int> &out);
+    void reset_scratch ();
+    bool is_valid ();
+
+    int size;
+    int shortcuts;
+    vector <int> rank;                              //Contraction order of each vertex
+    vector <int> first;                             //Offsets of each vertex's edges in up_edges
+    vector <CH_EDGE<W>> up_edges;                    //Edges pointing to higher ranked vertices only
+
+    //Preprocessing state
+    vector <vector <CH_EDGE<W>>> work;               //Remaining graph, holds only uncontracted vertices
+    vector <W> witness_dist;
+    vector <int> witness_hops;
+    vector <int> witness_touched;
+    vector <char> witness_target;                   //Neighbours the current witness search still has to settle
+    int targets_left;
+    vector <pair <int, CH_EDGE<W>>> pending;         //Shortcuts (from, edge) found by the last call to contract
+    vector <int> edge_slot;                         //Position of each neighbour in work [u] while u gets its shortcuts, -1 otherwise
+
+    //Query state, only the touched entries are reset between queries
+    vector <W> dist_fwd, dist_bwd;
+    vector <int> parent_fwd, parent_bwd;
+    vector <int> touched;
+};
+
+template <typename W>
+void ContractionHierarchy<W>::build (Graph<W> &g)
+{
+    INSTRUMENT_PHASE ("ch_build");
+    size = g.get_size ();
+    shortcuts = 0;
+    work.assign (size, vector <CH_EDGE<W>> ());
+    witness_dist.assign (size, inf_dist<W> ());
+    witness_hops.assign (size, 0);
+    witness_touched.clear ();
+    witness_target.assign (size, 0);
+    edge_slot.assign (size, -1);
+
+    //Copy the graph, dropping self loops and keeping the lightest of parallel edges
+    for (int v = 0; v < size; v++)
+    {
+        vector <NODE<W>> adjNodes = g.get_adjNodes (v);
+        for (size_t i = 0; i < adjNodes.size (); i++)
+        {
+            int u = adjNodes [i].vertex;
+            if (u == v)
+                continue;
+            bool found = false;
+            for (size_t j = 0; j < work [v].size (); j++)
+                if (work [v][j].vertex == u)
+                {
+                    work [v][j].weight = min (work [v][j].weight, adjNodes [i].weight);
+                    found = true;
+                    break;
+                }
+            if (!found)
+                work [v].push_back ({u, adjNodes [i].weight, -1});
+        }
+    }
+
+    //Order vertices by edge difference (shortcuts added - edges removed) plus the number of
+    //already contracted neighbours, which keeps the contraction spread evenly over the graph.
+    //Contracting a vertex adds one to the contracted neighbours of each of its neighbours, so
+    //they go back in the queue at once and their old entries are skipped when popped. Their edge
+    //differences are only recomputed lazily, when popped, as a full recount would run a witness
+    //search from each of their neighbours after every contraction.
+    vector <int> deleted_nbrs (size, 0), priority (size);
+    priority_queue <pair <int, int>, vector <pair <int, int>>, greater <pair <int, int>>> order;
+    for (int v = 0; v < size; v++)
+        order.push ({priority [v] = contract (v), v});
+
+    vector <vector <CH_EDGE<W>>> up (size);
+    vector <bool> contracted (size, false);
+    rank.assign (size, 0);
+    int next_rank = 0;
+    while (!order.empty ())
+    {
+        int v = order.top ().second;
+        if (contracted [v] || order.top ().first != priority [v])
+        {
+            order.pop ();
+            continue;
+        }
+        order.pop ();
+        priority [v] = contract (v) + deleted_nbrs [v];
+        if (!order.empty () && priority [v] > order.top ().first)
+        {
+            order.push ({priority [v], v});
+            continue;
+        }
+
+        //The shortcuts found while recomputing the priority are exactly the ones to add
+        add_shortcuts ();
+        rank [v] = next_rank++;
+        contracted [v] = true;
+        //Every remaining neighbour will be contracted later, so these edges all point upwards
+        up [v] = work [v];
+        for (size_t i = 0; i < work [v].size (); i++)
+        {
+            vector <CH_EDGE<W>> &nbr = work [work [v][i].vertex];
+            for (size_t j = 0; j < nbr.size (); j++)
+                if (nbr [j].vertex == v)
+                {
+                    nbr [j] = nbr.back ();
+                    nbr.pop_back ();
+                    break;
+                }
+            int u = work [v][i].vertex;
+            deleted_nbrs [u]++;
+            order.push ({++priority [u], u});
+        }
+        work [v].clear ();
+    }
+    work.clear ();
+    witness_dist.clear ();
+    witness_hops.clear ();
+    witness_target.clear ();
+    edge_slot.clear ();
+
+    //Flatten the upward graph so a query walks contiguous memory
+    first.assign (size + 1, 0);
+    up_edges.clear ();
+    for (int v = 0; v < size; v++)
+    {
+        first [v] = up_edges.size ();
+        up_edges.insert (up_edges.end (), up [v].begin (), up [v].end ());
+    }
+    first [size] = up_edges.size ();
+    reset_scratch ();
+}
+
+//Finds the shortcuts contracting v would need and leaves them in pending.
+//Returns the edge difference: shortcuts needed minus edges removed.
+template <typename W>
+int ContractionHierarchy<W>::contract (int v)
+{
+    vector <CH_EDGE<W>> &nbrs = work [v];
+    pending.clear ();
+    for (size_t i = 0; i < nbrs.size (); i++)
+    {
+        W max_via = 0;
+        for (size_t j = i + 1; j < nbrs.size (); j++)
+            max_via = max (max_via, nbrs [i].weight + nbrs [j].weight);
+        if (max_via == 0)
+            continue;
+
+        targets_left = nbrs.size () - i - 1;
+        for (size_t j = i + 1; j < nbrs.size (); j++)
+            witness_target [nbrs [j].vertex] = 1;
+        witness_search (nbrs [i].vertex, v, max_via);
+        for (size_t j = i + 1; j < nbrs.size (); j++)
+            witness_target [nbrs [j].vertex] = 0;
+        for (size_t j = i + 1; j < nbrs.size (); j++)
+        {
+            W via = nbrs [i].weight + nbrs [j].weight;
+            //No path avoiding v is as short, so the path through v must be kept as a shortcut
+            if (witness_dist [nbrs [j].vertex] > via)
+            {
+                pending.push_back ({nbrs [i].vertex, {nbrs [j].vertex, via, v}});
+            }
+        }
+    }
+    return (int) pending.size () - (int) nbrs.size ();
+}
+
+//Adds the shortcuts left in pending both ways, or lowers the weight of an edge already there.
+//They are grouped by the vertex they leave, whose edges are indexed in edge_slot meanwhile,
+//so finding an existing edge doesn't scan the list.
+template <typename W>
+void ContractionHierarchy<W>::add_shortcuts ()
+{
+    size_t n = pending.size ();
+    for (size_t i = 0; i < n; i++)
+        pending.push_back ({pending [i].second.vertex, {pending [i].first, pending [i].second.weight, pending [i].second.middle}});
+    sort (pending.begin (), pending.end (), [] (const pair <int, CH_EDGE<W>> &a, const pair <int, CH_EDGE<W>> &b) {return a.first < b.first;});
+    for (size_t begin = 0, end; begin < pending.size (); begin = end)
+    {
+        int u = pending [begin].first;
+        vector <CH_EDGE<W>> &edges = work [u];
+        for (size_t j = 0; j < edges.size (); j++)
+            edge_slot [edges [j].vertex] = j;
+        for (end = begin; end < pending.size () && pending [end].first == u; end++)
+        {
+            const CH_EDGE<W> &s = pending [end].second;
+            int slot = edge_slot [s.vertex];
+            if (slot < 0)
+            {
+                edge_slot [s.vertex] = edges.size ();
+                edges.push_back (s);
+                //The graph is undirected, count each new shortcut from its lower end only
+                if (u < s.vertex)
+                    shortcuts++;
+            }
+            else if (s.weight < edges [slot].weight)
+                edges [slot] = s;
+        }
+        for (size_t j = 0; j < edges.size (); j++)
+            edge_slot [edges [j].vertex] = -1;
+    }
+    pending.clear ();
+}
+
+//Local Dijkstra from src that ignores the vertex being contracted, it stops once every target
+//is settled as their distances can't get any shorter
+template <typename W>
+void ContractionHierarchy<W>::witness_search (int src, int skip, W limit)
+{
+    for (size_t i = 0; i < witness_touched.size (); i++)
+        witness_dist [witness_touched [i]] = inf_dist<W> ();
+    witness_touched.clear ();
+
+    priority_queue <pair <W, int>, vector <pair <W, int>>, greater <pair <W, int>>> PQ;
+    witness_dist [src] = 0;
+    witness_hops [src] = 0;
+    witness_touched.push_back (src);
+    PQ.push ({0, src});
+    int settled = 0;
+    while (!PQ.empty () && settled < CH_SETTLE_LIMIT)
+    {
+        W d = PQ.top ().first;
+        int u = PQ.top ().second;
+        PQ.pop ();
+        if (d > witness_dist [u])
+            continue;
+        if (d > limit)
+            break;
+        settled++;
+        if (witness_target [u] && --targets_left == 0)
+            break;
+        //A witness longer than CH_HOP_LIMIT edges isn't looked for, that only costs a shortcut
+        if (witness_hops [u] >= CH_HOP_LIMIT)
+            continue;
+        for (size_t i = 0; i < work [u].size (); i++)
+        {
+            int v = work [u][i].vertex;
+            W nd = d + work [u][i].weight;
+            if (v != skip && nd < witness_dist [v])
+            {
+                if (witness_dist [v] == inf_dist<W> ())
+                    witness_touched.push_back (v);
+                witness_dist [v] = nd;
+                witness_hops [v] = witness_hops [u] + 1;
+                PQ.push ({nd, v});
+            }
+        }
+    }
+}
+
+template <typename W>
+void ContractionHierarchy<W>::reset_scratch ()
+{
+    dist_fwd.assign (size, inf_dist<W> ());
+    dist_bwd.assign (size, inf_dist<W> ());
+    parent_fwd.assign (size, -1);
+    parent_bwd.assign (size, -1);
+    touched.clear ();
+}
+
+template <typename W>
+int ContractionHierarchy<W>::query (int src, int dst)
+{
+    INSTRUMENT_PHASE ("ch_query");
+    for (size_t i = 0; i < touched.size (); i++)
+    {
+        dist_fwd [touched [i]] = dist_bwd [touched [i]] = inf_dist<W> ();
+        parent_fwd [touched [i]] = parent_bwd [touched [i]] = -1;
+    }
+    touched.clear ();
+
+    typedef priority_queue <pair <W, int>, vector <pair <W, int>>, greater <pair <W, int>>> MinQueue;
+    MinQueue PQ [2];
+    vector <W>* dist [2] = {&dist_fwd, &dist_bwd};
+    vector <int>* parent [2] = {&parent_fwd, &parent_bwd};
+    dist_fwd [src] = 0;
+    dist_bwd [dst] = 0;
+    touched.push_back (src);
+    touched.push_back (dst);
+    PQ [0].push ({0, src});
+    PQ [1].push ({0, dst});
+
+    W best = inf_dist<W> ();
+    int meet = -1;
+    //Alternate between the two searches, each one stops once it can no longer beat best
+    for (int side = 0; !PQ [0].empty () || !PQ [1].empty (); side ^= 1)
+    {
+        MinQueue &Q = PQ [side];
+        if (Q.empty ())
+            continue;
+        W d = Q.top ().first;
+        int u = Q.top ().second;
+        Q.pop ();
+        if (d >= best)
+        {
+            Q = MinQueue ();
+            continue;
+        }
+        if (d > (*dist [side]) [u])
+            continue;
+        W other = (*dist [side ^ 1]) [u];
+        if (other != inf_dist<W> () && d + other < best)
+        {
+            best = d + other;
+            meet = u;
+        }
+        INSTRUMENT_ADD (EDGE_RELAXATIONS, first [u + 1] - first [u]);
+        for (int i = first [u]; i < first [u + 1]; i++)
+        {
+            int v = up_edges [i].vertex;
+            W nd = d + up_edges [i].weight;
+            if (nd < (*dist [side]) [v])
+            {
+                if (dist_fwd [v] == inf_dist<W> () && dist_bwd [v] == inf_dist<W> ())
+                    touched.push_back (v);
+                (*dist [side]) [v] = nd;
+                (*parent [side]) [v] = u;
+                Q.push ({nd, v});
+            }
+        }
+    }
+    return meet;
+}
+
+template <typename W>
+W ContractionHierarchy<W>::distance (int src, int dst)
+{
+    int meet = query (src, dst);
+    return (meet < 0) ? inf_dist<W> () : dist_fwd [meet] + dist_bwd [meet];
+}
+
+//Both ends of an edge are stored only with the lower ranked one
+template <typename W>
+const CH_EDGE<W>* ContractionHierarchy<W>::find_edge (int u, int v)
+{
+    if (rank [u] > rank [v])
+        swap (u, v);
+    for (int i = first [u]; i < first [u + 1]; i++)
+        if (up_edges [i].vertex == v)
+            return &up_edges [i];
+    return NULL;
+}
+
+//Appends the original vertices of edge u-v (excluding u) to out, expanding shortcuts recursively
+template <typename W>
+void ContractionHierarchy<W>::unpack (int u, int v, vector <int> &out)
+{
+    int middle = find_edge (u, v)->middle;
+    if (middle < 0)
+    {
+        out.push_back (v);
+        return;
+    }
+    unpack (u, middle, out);
+    unpack (middle, v, out);
+}
+
+template <typename W>
+vector <int> ContractionHierarchy<W>::path (int src, int dst)
+{
+    vector <int> result;
+    int meet = query (src, dst);
+    if (meet < 0)
+        return result;
+
+    //Hierarchy path: src .. meet from the forward search, then meet .. dst from the backward one
+    vector <int> hops;
+    for (int v = meet; v != -1; v = parent_fwd [v])
+        hops.push_back (v);
+    reverse (hops.begin (), hops.end ());
+    for (int v = parent_bwd [meet]; v != -1; v = parent_bwd [v])
+        hops.push_back (v);
+
+    result.push_back (src);
+    for (size_t i = 0; i + 1 < hops.size (); i++)
+        unpack (hops [i], hops [i + 1], result);
+    return result;
+}
+
+template <typename W>
+size_t ContractionHierarchy<W>::memory_bytes ()
+{
+    return rank.size () * sizeof (int) + first.size () * sizeof (int) + up_edges.size () * sizeof (CH_EDGE<W>);
+}
+
+//File layout: "CH01", weight size, vertex count, edge count, rank [size], first [size + 1], up_edges [edge count]
+template <typename W>
+bool ContractionHierarchy<W>::save (const string &file_name)
+{
+    ofstream out (file_name, ios::binary);
+    if (!out.is_open ())
+        return false;
+    int n_edges = up_edges.size ();
+    int weight_size = sizeof (W);
+    out.write ("CH01", 4);
+    out.write (reinterpret_cast <const char*> (&weight_size), sizeof (int));
+    out.write (reinterpret_cast <const char*> (&size), sizeof (int));
+    out.write (reinterpret_cast <const char*> (&n_edges), sizeof (int));
+    out.write (reinterpret_cast <const char*> (rank.data ()), size * sizeof (int));
+    out.write (reinterpret_cast <const char*> (first.data ()), (size + 1) * sizeof (int));
+    out.write (reinterpret_cast <const char*> (up_edges.data ()), n_edges * sizeof (CH_EDGE<W>));
+    return out.good ();
+}
+
+template <typename W>
+bool ContractionHierarchy<W>::load (const string &file_name)
+{
+    size = 0;
+    rank.clear ();
+    first.assign (1, 0);
+    up_edges.clear ();
+    ifstream in (file_name, ios::binary | ios::ate);
+    long long length = in.tellg ();
+    in.seekg (0);
+    char magic [4];
+    int weight_size, n_edges;
+    if (!in.read (magic, 4) || string (magic, 4) != "CH01")
+        return false;
+    //A hierarchy can only be loaded with the weight type it was built with
+    if (!in.read (reinterpret_cast <char*> (&weight_size), sizeof (int)) || weight_size != sizeof (W))
+        return false;
+    in.read (reinterpret_cast <char*> (&size), sizeof (int));
+    in.read (reinterpret_cast <char*> (&n_edges), sizeof (int));
+    if (!in || size < 0 || n_edges < 0)
+        return false;
+    //The file must hold exactly the arrays its header announces
+    if (length != 16 + (2LL * size + 1) * (long long) sizeof (int) + (long long) n_edges * (long long) sizeof (CH_EDGE<W>))
+    {
+        size = 0;
+        return false;
+    }
+    rank.resize (size);
+    first.resize (size + 1);
+    up_edges.resize (n_edges);
+    in.read (reinterpret_cast <char*> (rank.data ()), size * sizeof (int));
+    in.read (reinterpret_cast <char*> (first.data ()), (size + 1) * sizeof (int));
+    in.read (reinterpret_cast <char*> (up_edges.data ()), n_edges * sizeof (CH_EDGE<W>));
+    if (!in || !is_valid ())
+    {
+        size = 0;
+        rank.clear ();
+        first.assign (1, 0);
+        up_edges.clear ();
+        return false;
+    }
+    shortcuts = 0;
+    for (int i = 0; i < n_edges; i++)
+        if (up_edges [i].middle >= 0)
+            shortcuts++;
+    reset_scratch ();
+    return true;
+}
+
+//Checks a loaded hierarchy before a query walks it: the ranks are a permutation, the offsets climb
+//from 0 to the edge count, every edge leads to a higher ranked vertex, and every shortcut bypasses
+//a lower ranked vertex through two edges that exist, so unpacking a path always terminates
+template <typename W>
+bool ContractionHierarchy<W>::is_valid ()
+{
+    vector <bool> seen (size, false);
+    for (int v = 0; v < size; v++)
+    {
+        if (rank [v] < 0 || rank [v] >= size || seen [rank [v]])
+            return false;
+        seen [rank [v]] = true;
+    }
+    if (first [0] != 0 || first [size] != (int) up_edges.size ())
+        return false;
+    for (int v = 0; v < size; v++)
+        if (first [v + 1] < first [v])
+            return false;
+    for (int u = 0; u < size; u++)
+        for (int i = first [u]; i < first [u + 1]; i++)
+        {
+            int v = up_edges [i].vertex;
+            if (v < 0 || v >= size || rank [v] <= rank [u])
+                return false;
+        }
+    for (int u = 0; u < size; u++)
+        for (int i = first [u]; i < first [u + 1]; i++)
+        {
+            int middle = up_edges [i].middle;
+            if (middle < -1 || middle >= size)
+                return false;
+            if (middle >= 0 && (rank [middle] >= rank [u] || !find_edge (u, middle) || !find_edge (middle, up_edges [i].vertex)))
+                return false;
+        }
+    return true;
+}
+
+//Distances summed in a different order may differ in the last bits for floating point weights
+template <typename W>
+bool same_dist (W a, W b)
+{
+    if (a == b)
+        return true;
+    if constexpr (is_floating_point<W>::value)
+        return a != inf_dist<W> () && b != inf_dist<W> () && fabs (a - b) <= 1e-4 * max (a, b);
+    return false;
+}
+
+//Compares preprocessing time, memory and query latency of the hierarchy against plain Dijkstra
+template <typename Queue, typename W>
+void benchmark_ch (int n, double density, int queries)
+{
+    typedef chrono::steady_clock Clock;
+    Graph<W> g(n, density);
+    size_t graph_bytes = 0;
+    for (int v = 0; v < n; v++)
+        graph_bytes += g.get_adjNodes (v).size () * sizeof (ADJ_NODE<W>);
+
+    Clock::time_point start = Clock::now ();
+    ContractionHierarchy<W> ch(g);
+    double build_ms = chrono::duration <double, milli> (Clock::now () - start).count ();
+
+    default_random_engine e(time(0));
+    uniform_int_distribution <int> d(0, n - 1);
+    vector <pair <int, int>> pairs;
+    for (int i = 0; i < queries; i++)
+        pairs.push_back ({d (e), d (e)});
+
+    vector <W> plain (queries), fast (queries);
+    start = Clock::now ();
+    for (int i = 0; i < queries; i++)
+        plain [i] = dijkstra_query<Queue> (g, pairs [i].first, pairs [i].second);
+    double plain_us = chrono::duration <double, micro> (Clock::now () - start).count () / queries;
+
+    start = Clock::now ();
+    for (int i = 0; i < queries; i++)
+        fast [i] = ch.distance (pairs [i].first, pairs [i].second);
+    double fast_us = chrono::duration <double, micro> (Clock::now () - start).count () / queries;
+
+    int mismatches = 0;
+    for (int i = 0; i < queries; i++)
+        if (!same_dist (plain [i], fast [i]))
+            mismatches++;
+
+    cout << "Vertices: " << n << "\tDensity: " << density << "\tQueries: " << queries << "\n\n";
+    cout << "Preprocessing:\t\t" << build_ms << " ms, " << ch.shortcut_count () << " shortcuts\n";
+    cout << "Memory:\t\t\tgraph " << graph_bytes << " bytes, hierarchy " << ch.memory_bytes () << " bytes\n";
+    cout << "Query latency:\t\tdijkstra " << plain_us << " us, hierarchy " << fast_us << " us\n";
+    cout << "Checked " << queries << " queries against dijkstra, " << mismatches << " mismatches\n";
+}
+
+//Compares k nearest queries from random sources done by a full search against the same queries
+//done by LocalSearch, which stops after k vertices and resets nothing between queries
+template <typename Queue, typename W>
+void benchmark_local (int n, double density, int queries, int k)
+{
+    typedef chrono::steady_clock Clock;
+    Graph<W> g(n, density);
+    default_random_engine e(time(0));
+    uniform_int_distribution <int> d(0, n - 1);
+    vector <int> sources;
+    for (int i = 0; i < queries; i++)
+        sources.push_back (d (e));
+
+    vector <vector <W>> expected (queries);
+    vector <W> dist;
+    vector <int> parent;
+    Clock::time_point start = Clock::now ();
+    for (int i = 0; i < queries; i++)
+    {
+        dijkstra_search<Queue> (g, sources [i], dist, parent);
+        //The k smallest distances are the answer a full search gives
+        expected [i] = dist;
+        int count = min (k, n);
+        partial_sort (expected [i].begin (), expected [i].begin () + count, expected [i].end ());
+        expected [i].resize (count);
+    }
+    double full_us = chrono::duration <double, micro> (Clock::now () - start).count () / queries;
+
+    LocalSearch<Queue, W> local(n);
+    int mismatches = 0;
+    start = Clock::now ();
+    for (int i = 0; i < queries; i++)
+    {
+        const vector <int> &nearest = local.nearest (g, sources [i], k);
+        for (size_t j = 0; j < expected [i].size (); j++)
+            if (j >= nearest.size () ? expected [i][j] != inf_dist<W> () : !same_dist (local.distance (nearest [j]), expected [i][j]))
+                mismatches++;
+    }
+    double local_us = chrono::duration <double, micro> (Clock::now () - start).count () / queries;
+
+    cout << "Vertices: " << n << "\tDensity: " << density << "\tQueries: " << queries << "\tk: " << k << "\n\n";
+    cout << "Query latency:\t\tfull search " << full_us << " us, local search " << local_us << " us\n";
+    cout << "Checked " << queries << " queries against the full search, " << mismatches << " mismatches\n";
+}
+
+//Times single source searches from the same random sources with every priority queue,
+//and checks their distances against the binary heap
+template <typename W>
+void benchmark_heaps (int n, double density, int searches)
+{
+    typedef chrono::steady_clock Clock;
+    const HeapPolicy policies [] = {HeapPolicy::Binary, HeapPolicy::Dary, HeapPolicy::Radix, HeapPolicy::Bucket, HeapPolicy::Fibonacci};
+    const char* names [] = {"binary", "dary", "radix", "bucket", "fibonacci"};
+    Graph<W> g(n, density);
+    default_random_engine e(time(0));
+    uniform_int_distribution <int> d(0, n - 1);
+    vector <int> sources;
+    for (int i = 0; i < searches; i++)
+        sources.push_back (d (e));
+
+    cout << "Vertices: " << n << "\tDensity: " << density << "\tSearches: " << searches << "\n\n";
+    vector <vector <W>> expected (searches);
+    int mismatches = 0;
+    for (int p = 0; p < 5; p++)
+    {
+        double ms = 0;
+        with_heap<W> (policies [p], [&] (auto tag) {
+            vector <W> dist;
+            vector <int> parent;
+            for (int i = 0; i < searches; i++)
+            {
+                Clock::time_point start = Clock::now ();
+                dijkstra_search<typename decltype (tag)::type> (g, sources [i], dist, parent);
+                ms += chrono::duration <double, milli> (Clock::now () - start).count ();
+                if (p == 0)
+                    expected [i] = dist;
+                else
+                    for (int v = 0; v < n; v++)
+                        if (!same_dist (dist [v], expected [i][v]))
+                            mismatches++;
+            }
+        });
+        cout << names [p] << "\t\t" << ms / searches << " ms per search\n";
+    }
+    if (!is_integral<W>::value)
+        cout << "Radix and bucket need integer weights, they ran the dary heap\n";
+
+    //Every vertex order with the 4-ary heap, all on compressed rows so only the numbering differs
+    const VertexOrder orders [] = {VertexOrder::Input, VertexOrder::Bfs, VertexOrder::CuthillMcKee, VertexOrder::Degree};
+    const char* order_names [] = {"input", "bfs", "rcm", "degree"};
+    cout << "\nVertex orders with the dary heap:\n";
+    for (int o = 0; o < 4; o++)
+    {
+        Clock::time_point start = Clock::now ();
+        Renumbering r(g, orders [o]);
+        CsrGraph<W> renumbered = r.apply<W> (g);
+        double renumber_ms = chrono::duration <double, milli> (Clock::now () - start).count ();
+        double ms = 0;
+        vector <W> dist;
+        vector <int> parent;
+        for (int i = 0; i < searches; i++)
+        {
+            start = Clock::now ();
+            dijkstra_search<PriorityQueue<W, QuaternaryHeap>> (renumbered, r.to_new (sources [i]), dist, parent);
+            ms += chrono::duration <double, milli> (Clock::now () - start).count ();
+            dist = r.restore (dist);
+            for (int v = 0; v < n; v++)
+                if (!same_dist (dist [v], expected [i][v]))
+                    mismatches++;
+        }
+        cout << order_names [o] << "\t\t" << ms / searches << " ms per search, " << renumber_ms << " ms to renumber\n";
+    }
+    cout << "Checked every distance against the binary heap, " << mismatches << " mismatches\n";
+}
+
+#endif
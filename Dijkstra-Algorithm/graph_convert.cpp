@@ -0,0 +1,171 @@
+/*Converts graphs to the compressed rows file that dijkstra --csr searches from a memory map
+
+    graph_convert [--weights T] [--undirected] <edges.txt> <out.csr>
+    graph_convert [--weights T] --random <out.csr> <nodes> <density> [seed]
+
+An edge file has one "u v weight" line per directed edge, vertices numbered from 0. A line holding
+a single number gives the vertex count, as in Prim's week4_hw.txt, and lines that don't start with
+a number (comments, headers) are skipped. A negative weight stops the conversion with its line
+number, dijkstra can't search such a graph. The file is read twice, once to count the edges of each
+vertex and once to write them into place, so only the counts are ever held in memory.
+*/
+
+#include "Dijkstra_list.h"
+#include "../Graph-Library/mapped_graph.h"
+
+//Reads up to three numbers from line, returns how many were read
+template <typename W>
+int parse_edge (const string &line, long long &u, long long &v, W &w)
+{
+        const char* p = line.data ();
+        const char* end = p + line.size ();
+        auto next = [&] (auto &value) {
+            while (p < end && (*p == ' ' || *p == '\t' || *p == ','))
+                p++;
+            from_chars_result res = from_chars (p, end, value);
+            if (res.ec != errc ())
+                return false;
+            p = res.ptr;
+            return true;
+        };
+        if (!next (u))
+            return 0;
+        if (!next (v))
+            return 1;
+        return next (w) ? 3 : 2;
+}
+
+template <typename W>
+int convert_edges (const string &in_name, const string &out_name, bool undirected)
+{
+        typedef chrono::steady_clock Clock;
+        Clock::time_point start = Clock::now ();
+        vector <uint64_t> degree;
+        string line;
+        long long u, v, skipped = 0, line_number = 0;
+        W w;
+        //First pass: the number of edges leaving each vertex
+        ifstream in (in_name);
+        if (!in.is_open ())
+        {
+            cout << "Failed to read " << in_name << endl;
+            return 1;
+        }
+        while (getline (in, line))
+        {
+            line_number++;
+            int fields = parse_edge (line, u, v, w);
+            if (fields == 1 && u >= 0 && u <= INT32_MAX && degree.size () < (size_t) u)
+                degree.resize (u, 0);
+            if (fields != 3)
+                continue;
+            if (u < 0 || v < 0 || u >= INT32_MAX || v >= INT32_MAX)
+            {
+                skipped++;
+                continue;
+            }
+            //Dijkstra is only right for weights that never shorten a path, NaN fails this test too
+            if (!(w >= 0))
+            {
+                cout << "Negative or NaN weight on line " << line_number << " of " << in_name << endl;
+                return 1;
+            }
+            if (degree.size () <= (size_t) max (u, v))
+                degree.resize (max (u, v) + 1, 0);
+            degree [u]++;
+            if (undirected)
+                degree [v]++;
+        }
+
+        //Second pass: every edge straight into its place in the file
+        CsrFileWriter<W> out;
+        if (!out.create (out_name, degree))
+        {
+            cout << "Failed to write " << out_name << endl;
+            return 1;
+        }
+        in.clear ();
+        in.seekg (0);
+        while (getline (in, line))
+        {
+            if (parse_edge (line, u, v, w) != 3 || u < 0 || v < 0 || u >= INT32_MAX || v >= INT32_MAX)
+                continue;
+            out.add (u, v, w);
+            if (undirected)
+                out.add (v, u, w);
+        }
+        if (!out.close ())
+        {
+            cout << "Failed to write " << out_name << endl;
+            return 1;
+        }
+        uint64_t edges = 0;
+        for (size_t i = 0; i < degree.size (); i++)
+            edges += degree [i];
+        cout << "Wrote " << degree.size () << " vertices and " << edges << " edges in "
+             << chrono::duration <double, milli> (Clock::now () - start).count () << " ms\n";
+        if (skipped)
+            cout << "Skipped " << skipped << " edges with vertices out of range\n";
+        return 0;
+}
+
+//The same random graph dijkstra generates, for trying the file format out
+template <typename W>
+int convert_random (const vector <string> &args)
+{
+        int n = stoi (args [2]);
+        double density = stod (args [3]);
+        unsigned seed = (args.size () > 4) ? stoul (args [4]) : time (0);
+        Graph<W> g(n, density, seed);
+        if (!write_csr_file<W> (args [1], g))
+        {
+            cout << "Failed to write " << args [1] << endl;
+            return 1;
+        }
+        cout << "Wrote a random graph of " << n << " vertices\n";
+        return 0;
+}
+
+template <typename W>
+int convert (const vector <string> &args, bool undirected)
+{
+        if (args.size () > 3 && args [0] == "--random")
+            return convert_random<W> (args);
+        if (args.size () == 2)
+            return convert_edges<W> (args [0], args [1], undirected);
+        cout << "Usage: graph_convert [--weights int32|int64|float|double] [--undirected] <edges.txt> <out.csr>\n"
+             << "       graph_convert [--weights int32|int64|float|double] --random <out.csr> <nodes> <density> [seed]" << endl;
+        return 1;
+}
+
+int main (int argc, char* argv [])
+{
+        vector <string> args (argv + 1, argv + argc);
+        //--weights picks the weight type stored in the file, int32 by default as in dijkstra.
+        //--undirected stores every edge in both directions.
+        string weights = "int32";
+        bool undirected = false;
+        while (!args.empty () && (args [0] == "--weights" || args [0] == "--undirected"))
+        {
+            if (args [0] == "--undirected")
+            {
+                undirected = true;
+                args.erase (args.begin ());
+                continue;
+            }
+            if (args.size () < 2)
+                break;
+            weights = args [1];
+            args.erase (args.begin (), args.begin () + 2);
+        }
+        if (weights == "int32")
+            return convert <int32_t> (args, undirected);
+        if (weights == "int64")
+            return convert <int64_t> (args, undirected);
+        if (weights == "float")
+            return convert <float> (args, undirected);
+        if (weights == "double")
+            return convert <double> (args, undirected);
+        cout << "Unknown weight type " << weights << ", expected int32, int64, float or double" << endl;
+        return 1;
+}
@@ -0,0 +1,55 @@
+/*Buffered text output for exporting results
+
+    CsvWriter out("tree.csv");
+    out.text("vertex,parent\n");
+    out.field(v);       //Any integer or floating point value
+    out.close();        //False if anything failed to write
+
+Values are formatted with to_chars into one large buffer, written out a megabyte at a time
+instead of a stream call per value.
+*/
+
+#ifndef GRAPH_CSV_WRITER_H
+#define GRAPH_CSV_WRITER_H
+
+#include <charconv>
+#include <fstream>
+#include <string>
+
+class CsvWriter
+{
+public:
+    explicit CsvWriter(const std::string &file_name) : out(file_name, std::ios::binary) { buffer.reserve(BUFFER_SIZE); }
+    bool is_open() { return out.is_open(); }
+    template <typename T>
+    void field(T value)
+    {
+        char text[32];
+        std::to_chars_result res = std::to_chars(text, text + sizeof(text), value);
+        buffer.append(text, res.ptr);
+        if (buffer.size() >= BUFFER_SIZE)
+            flush();
+    }
+    void text(const char *value) { buffer += value; }
+    bool close()
+    {
+        flush();
+        out.close();
+        return !out.fail();
+    }
+    ~CsvWriter() { flush(); }
+
+private:
+    CsvWriter(const CsvWriter &) = delete;
+    CsvWriter &operator=(const CsvWriter &) = delete;
+    void flush()
+    {
+        out.write(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+    static const size_t BUFFER_SIZE = 1 << 20;
+    std::ofstream out;
+    std::string buffer;
+};
+
+#endif
@@ -0,0 +1,193 @@
+/*Dijkstra's and Prim's algorithms over any graph storage and priority queue
+
+Both take the queue as their first template parameter, e.g.
+
+    dijkstra_search<PriorityQueue<int, RadixHeap>>(g, src, dist, parent);
+    prim_search<PriorityQueue<int, QuaternaryHeap>>(g, 0, parent, min_dist);
+
+and the graph as anything graph_storage.h describes. LocalSearch answers many small searches
+on one graph, each bounded by a radius or a number of vertices.
+*/
+
+#ifndef GRAPH_ALGORITHMS_H
+#define GRAPH_ALGORITHMS_H
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include "priority_queues.h"
+#include "graph_storage.h"
+#include "instrumentation.h"
+
+//Infinite distance for weight type W: a real infinity for floating point weights,
+//the largest value for integers. Unreached vertices are skipped, so it's never added to.
+template <typename W>
+W inf_dist() { return std::numeric_limits<W>::has_infinity ? std::numeric_limits<W>::infinity() : std::numeric_limits<W>::max(); }
+
+//Single source shortest paths from src. Fills the distance of every vertex, inf_dist if it
+//can't be reached, and its parent on the path, -1 for src and unreached vertices.
+//With dst >= 0 the search stops as soon as dst leaves the queue, its distance is final by then.
+template <typename Queue, typename G, typename W>
+void dijkstra_search(G &g, int src, std::vector<W> &dist, std::vector<int> &parent, int dst = -1)
+{
+    INSTRUMENT_PHASE("dijkstra_search");
+    int n = g.get_size();
+    dist.assign(n, inf_dist<W>());
+    parent.assign(n, -1);
+    Queue PQ(n);
+
+    dist[src] = 0;
+    PQ.push(src, 0);
+    while (!PQ.is_empty())
+    {
+        int top = PQ.pop(); //top is the vertex with top priority (least distance)
+        if (top == dst)
+            break;
+        g.for_each_edge(top, [&](int v, W w) {
+            INSTRUMENT_COUNT(EDGE_RELAXATIONS);
+            if (w + dist[top] < dist[v])
+            {
+                dist[v] = w + dist[top];
+                parent[v] = top;
+                PQ.push(v, dist[v]);
+            }
+        });
+    }
+}
+
+//True if parent holds a forest over its n vertices, as the searches leave it: every entry is -1 or
+//a vertex, and following parents from any vertex reaches a -1 without going round a cycle.
+//For checking parents read back from a file before a path is followed through them.
+inline bool is_parent_forest(const std::vector<int> &parent)
+{
+    int n = parent.size();
+    for (int v = 0; v < n; v++)
+        if (parent[v] < -1 || parent[v] >= n)
+            return false;
+    //0 not seen yet, 1 on the chain being followed, 2 known to end at -1
+    std::vector<char> state(n, 0);
+    std::vector<int> chain;
+    for (int v = 0; v < n; v++)
+    {
+        int u = v;
+        for (; u >= 0 && state[u] == 0; u = parent[u])
+        {
+            state[u] = 1;
+            chain.push_back(u);
+        }
+        if (u >= 0 && state[u] == 1)
+            return false;
+        for (size_t i = 0; i < chain.size(); i++)
+            state[chain[i]] = 2;
+        chain.clear();
+    }
+    return true;
+}
+
+//Dijkstra's algorithm for many searches on the same graph that each stop early, e.g. the k
+//nearest vertices or those within a radius. Every entry of the scratch arrays is stamped with the
+//search that wrote it and entries of older searches read as unreached, so nothing is reset between
+//searches and each one costs only the vertices it reaches, not O(n):
+//
+//    LocalSearch<PriorityQueue<int, BucketQueue>, int> local(g.get_size());
+//    for (int v : local.nearest(g, src, 10))
+//        cout << v << " at " << local.distance(v) << "\n";
+template <typename Queue, typename W>
+class LocalSearch
+{
+public:
+    explicit LocalSearch(int n) : PQ(n), search(0), stamp(n, 0), dist(n), parent(n) {}
+    //Vertices settled by increasing distance from src while no further than radius, and at most
+    //k of them if k >= 0. Holds until the next search.
+    template <typename G>
+    const std::vector<int> &run(G &g, int src, W radius, int k = -1);
+    template <typename G>
+    const std::vector<int> &nearest(G &g, int src, int k) { return run(g, src, inf_dist<W>(), k); }
+    template <typename G>
+    const std::vector<int> &within(G &g, int src, W radius) { return run(g, src, radius); }
+    //Final for the vertices settled by the last search, inf_dist and -1 for those it didn't reach
+    W distance(int v) { return (stamp[v] == search) ? dist[v] : inf_dist<W>(); }
+    int get_parent(int v) { return (stamp[v] == search) ? parent[v] : -1; }
+    const std::vector<int> &get_settled() { return settled; }
+
+private:
+    Queue PQ;
+    unsigned search;             //Number of the current search
+    std::vector<unsigned> stamp; //Search that last reached each vertex
+    std::vector<W> dist;
+    std::vector<int> parent;
+    std::vector<int> settled;
+};
+
+template <typename Queue, typename W>
+template <typename G>
+const std::vector<int> &LocalSearch<Queue, W>::run(G &g, int src, W radius, int k)
+{
+    INSTRUMENT_PHASE("local_search");
+    //After 2^32 searches a stamp could match an old search again, start the numbering over
+    if (++search == 0)
+    {
+        std::fill(stamp.begin(), stamp.end(), 0);
+        search = 1;
+    }
+    settled.clear();
+    stamp[src] = search;
+    dist[src] = 0;
+    parent[src] = -1;
+    PQ.push(src, 0);
+    while (!PQ.is_empty() && k != (int)settled.size() && !(radius < dist[PQ.top()]))
+    {
+        int top = PQ.pop();
+        settled.push_back(top);
+        g.for_each_edge(top, [&](int v, W w) {
+            INSTRUMENT_COUNT(EDGE_RELAXATIONS);
+            if (stamp[v] != search || w + dist[top] < dist[v])
+            {
+                stamp[v] = search;
+                dist[v] = w + dist[top];
+                parent[v] = top;
+                PQ.push(v, dist[v]);
+            }
+        });
+    }
+    //Whatever is still queued was reached but not settled: forget it and empty the queue for the next search
+    while (!PQ.is_empty())
+        stamp[PQ.pop()] = search - 1;
+    return settled;
+}
+
+//Prim's algorithm from root. Fills the parent of every vertex in the tree, -1 for root and for
+//vertices not connected to it, and the weight of the edge to it, inf_dist if not connected.
+//A negative weight means there is no edge, a zero weight is an edge like any other. Storage with
+//its own marker for a missing edge, such as the adjacency matrix's 0, skips it in for_each_edge.
+template <typename Queue, typename G, typename W>
+void prim_search(G &g, int root, std::vector<int> &parent, std::vector<W> &min_dist)
+{
+    INSTRUMENT_PHASE("prim_search");
+    int n = g.get_size();
+    parent.assign(n, -1);
+    min_dist.assign(n, inf_dist<W>());
+    if (n == 0)
+        return;
+    std::vector<bool> visited(n, false);
+    Queue PQ(n);
+
+    min_dist[root] = 0;
+    PQ.push(root, 0);
+    while (!PQ.is_empty())
+    {
+        int top = PQ.pop();
+        visited[top] = true;
+        g.for_each_edge(top, [&](int v, W w) {
+            INSTRUMENT_COUNT(EDGE_RELAXATIONS);
+            if (w >= 0 && visited[v] == false && w < min_dist[v])
+            {
+                min_dist[v] = w;
+                parent[v] = top;
+                PQ.push(v, w);
+            }
+        });
+    }
+}
+
+#endif
@@ -0,0 +1,87 @@
+/*Graph storage shared by the graph algorithms
+
+The algorithms don't depend on how a graph is stored. Any class with
+
+    int get_size();
+    template <typename F> void for_each_edge(int v, F f);   //Calls f(target, weight) for each edge of v
+
+can be searched, e.g. the adjacency lists of Dijkstra_list, the matrix of Prim_matrix or the
+compressed rows below.
+*/
+
+#ifndef GRAPH_STORAGE_H
+#define GRAPH_STORAGE_H
+
+#include <vector>
+#include <cstddef>
+
+//Compressed sparse rows: the edges of vertex v are targets and weights [first[v], first[v + 1]),
+//three flat arrays instead of a list or a vector per vertex
+template <typename W>
+class CsrGraph
+{
+public:
+    CsrGraph() : size(0), first(1, 0) {}
+    //Edges is a sequence of directed edges with members u, v and weight
+    template <typename Edges>
+    CsrGraph(int n, const Edges &edges);
+    //Copies any other storage
+    template <typename G>
+    static CsrGraph from_graph(G &g);
+    int get_size() { return size; }
+    size_t edge_count() { return targets.size(); }
+    size_t begin(int v) { return first[v]; }
+    size_t end(int v) { return first[v + 1]; }
+    int target(size_t e) { return targets[e]; }
+    W weight(size_t e) { return weights[e]; }
+    template <typename F>
+    void for_each_edge(int v, F f)
+    {
+        for (size_t e = first[v]; e < first[v + 1]; e++)
+            f(targets[e], weights[e]);
+    }
+
+private:
+    int size;
+    std::vector<size_t> first;
+    std::vector<int> targets;
+    std::vector<W> weights;
+};
+
+template <typename W>
+template <typename Edges>
+CsrGraph<W>::CsrGraph(int n, const Edges &edges) : size(n), first(n + 1, 0), targets(edges.size()), weights(edges.size())
+{
+    //Counting sort of the edges by source vertex
+    for (size_t i = 0; i < edges.size(); i++)
+        first[edges[i].u + 1]++;
+    for (int v = 0; v < n; v++)
+        first[v + 1] += first[v];
+    std::vector<size_t> next(first.begin(), first.end() - 1);
+    for (size_t i = 0; i < edges.size(); i++)
+    {
+        size_t e = next[edges[i].u]++;
+        targets[e] = edges[i].v;
+        weights[e] = edges[i].weight;
+    }
+}
+
+template <typename W>
+template <typename G>
+CsrGraph<W> CsrGraph<W>::from_graph(G &g)
+{
+    CsrGraph<W> csr;
+    csr.size = g.get_size();
+    csr.first.assign(csr.size + 1, 0);
+    for (int v = 0; v < csr.size; v++)
+    {
+        g.for_each_edge(v, [&](int u, W w) {
+            csr.targets.push_back(u);
+            csr.weights.push_back(w);
+        });
+        csr.first[v + 1] = csr.targets.size();
+    }
+    return csr;
+}
+
+#endif
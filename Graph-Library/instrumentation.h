@@ -0,0 +1,135 @@
+/*Hot path counters and phase timing for the three programs, compiled out unless INSTRUMENT is defined
+
+    INSTRUMENT_COUNT(HEAP_PUSHES);          //Adds one to a counter
+    INSTRUMENT_ADD(EDGE_RELAXATIONS, n);    //Adds n
+    INSTRUMENT_PHASE("search");             //Times the rest of the enclosing scope
+
+Each thread counts into a block of its own, so counting is a plain increment with no atomics or
+locks. The blocks are summed once at exit, when the counters and the total time, number of runs
+of every phase go out as JSON to the file named by the INSTRUMENT_JSON environment variable, or
+to stderr without it. Without INSTRUMENT the macros expand to nothing.
+*/
+
+#ifndef GRAPH_INSTRUMENTATION_H
+#define GRAPH_INSTRUMENTATION_H
+
+#ifdef INSTRUMENT
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+enum Counter
+{
+    PLAYOUTS,
+    FIND_CALLS,
+    UNION_CALLS,
+    HEAP_PUSHES,
+    DECREASE_KEYS,
+    HEAP_POPS,
+    EDGE_RELAXATIONS,
+    COUNTER_COUNT
+};
+
+class Instrumentation
+{
+public:
+    static Instrumentation &get()
+    {
+        static Instrumentation instance;
+        return instance;
+    }
+    //This thread's counters
+    static uint64_t *counters()
+    {
+        thread_local uint64_t *block = get().add_block();
+        return block;
+    }
+    void add_phase(const char *name, double ms)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        PHASE &phase = phases[name];
+        phase.runs++;
+        phase.ms += ms;
+    }
+    ~Instrumentation() { dump(); }
+
+private:
+    struct PHASE
+    {
+        uint64_t runs = 0;
+        double ms = 0;
+    };
+    Instrumentation() {}
+    uint64_t *add_block()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        blocks.push_back(std::unique_ptr<uint64_t[]>(new uint64_t[COUNTER_COUNT]()));
+        return blocks.back().get();
+    }
+    void dump()
+    {
+        static const char *names[COUNTER_COUNT] = {"playouts", "find_calls", "union_calls", "heap_pushes",
+                                                   "decrease_keys", "heap_pops", "edge_relaxations"};
+        const char *file_name = std::getenv("INSTRUMENT_JSON");
+        FILE *out = file_name ? std::fopen(file_name, "w") : stderr;
+        if (!out)
+            return;
+        std::fprintf(out, "{\n  \"counters\": {");
+        for (int c = 0; c < COUNTER_COUNT; c++)
+        {
+            uint64_t total = 0;
+            for (size_t b = 0; b < blocks.size(); b++)
+                total += blocks[b][c];
+            std::fprintf(out, "%s\n    \"%s\": %llu", c ? "," : "", names[c], (unsigned long long)total);
+        }
+        std::fprintf(out, "\n  },\n  \"phases\": {");
+        bool first = true;
+        for (auto &phase : phases)
+        {
+            std::fprintf(out, "%s\n    \"%s\": {\"runs\": %llu, \"ms\": %.3f}", first ? "" : ",", phase.first.c_str(),
+                         (unsigned long long)phase.second.runs, phase.second.ms);
+            first = false;
+        }
+        std::fprintf(out, "\n  }\n}\n");
+        if (out != stderr)
+            std::fclose(out);
+    }
+    std::mutex lock;
+    std::vector<std::unique_ptr<uint64_t[]>> blocks; //Kept after their thread exits
+    std::map<std::string, PHASE> phases;
+};
+
+//Adds the time from its construction to its destruction to a phase, on the monotonic clock
+class PhaseTimer
+{
+public:
+    explicit PhaseTimer(const char *phase) : name(phase), start(std::chrono::steady_clock::now()) {}
+    ~PhaseTimer() { Instrumentation::get().add_phase(name, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()); }
+
+private:
+    const char *name;
+    std::chrono::steady_clock::time_point start;
+};
+
+#define INSTRUMENT_CONCAT_(a, b) a##b
+#define INSTRUMENT_CONCAT(a, b) INSTRUMENT_CONCAT_(a, b)
+#define INSTRUMENT_COUNT(counter) (Instrumentation::counters()[counter]++)
+#define INSTRUMENT_ADD(counter, n) (Instrumentation::counters()[counter] += (n))
+#define INSTRUMENT_PHASE(name) PhaseTimer INSTRUMENT_CONCAT(phase_timer_, __LINE__)(name)
+
+#else
+
+#define INSTRUMENT_COUNT(counter) ((void)0)
+#define INSTRUMENT_ADD(counter, n) ((void)0)
+#define INSTRUMENT_PHASE(name) ((void)0)
+
+#endif
+
+#endif
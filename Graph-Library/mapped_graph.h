@@ -0,0 +1,451 @@
+/*Compressed rows in a file, searched straight from a memory map
+
+A graph too large for the heap, or one loaded over and over, is converted once to this layout:
+
+    char magic [4]              "CSR1"
+    uint32_t weight_size        bytes per weight
+    uint32_t weight_kind        0 for integer weights, 1 for floating point ones
+    uint32_t reserved
+    uint64_t vertices, edges
+    double max_weight           largest weight of any edge, 0 without edges
+    uint64_t first [vertices + 1]   the edges of vertex v are [first [v], first [v + 1])
+    CsrEdge<W> edge [edges]         target and weight of each edge next to each other
+
+in the byte order of the machine that wrote it. Nothing is parsed or copied: opening the file maps
+it and reads only the header, then the operating system pages in only what a search touches and
+can drop clean pages again under memory pressure, so the graph may be larger than RAM. The offsets,
+targets and weights of a vertex are checked when a search reaches it, and a file found corrupt
+that way says so afterwards; check() reads the whole file up front instead:
+
+    MappedCsrGraph<int> g;
+    if (g.open("roads.csr"))
+        dijkstra_search<Queue>(g, src, dist, parent);
+    if (g.is_corrupt())
+        ...
+
+Without mmap (Windows) the file is read into memory instead, and written from memory.
+*/
+
+#ifndef GRAPH_MAPPED_GRAPH_H
+#define GRAPH_MAPPED_GRAPH_H
+
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <type_traits>
+#include <limits>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "instrumentation.h"
+
+template <typename W>
+struct CsrEdge
+{
+    int32_t target;
+    W weight;
+};
+
+struct CsrFileHeader
+{
+    char magic[4];
+    uint32_t weight_size;
+    uint32_t weight_kind;
+    uint32_t reserved;
+    uint64_t vertices;
+    uint64_t edges;
+    double max_weight;
+};
+
+//Reads just the header, false if file_name isn't a compressed rows file
+inline bool read_csr_header(const std::string &file_name, CsrFileHeader &header)
+{
+    FILE *in = std::fopen(file_name.c_str(), "rb");
+    if (!in)
+        return false;
+    bool ok = std::fread(&header, sizeof(header), 1, in) == 1 && std::memcmp(header.magic, "CSR1", 4) == 0;
+    std::fclose(in);
+    return ok;
+}
+
+template <typename W>
+bool csr_weights_match(const CsrFileHeader &header)
+{
+    return header.weight_size == sizeof(W) && header.weight_kind == (std::is_floating_point<W>::value ? 1u : 0u);
+}
+
+//Bytes of a file of n vertices and m edges. Every section starts 8 byte aligned.
+template <typename W>
+size_t csr_file_size(uint64_t n, uint64_t m)
+{
+    return sizeof(CsrFileHeader) + (n + 1) * sizeof(uint64_t) + m * sizeof(CsrEdge<W>);
+}
+
+//A whole file in memory: mapped where the platform allows it, read into a buffer elsewhere
+class FileMapping
+{
+public:
+    FileMapping() : data(NULL), length(0), writable(false) {}
+    FileMapping(const FileMapping &) = delete;
+    FileMapping &operator=(const FileMapping &) = delete;
+    ~FileMapping() { close(); }
+    bool open(const std::string &file_name);
+    //Creates or truncates the file to length bytes, mapped for writing
+    bool create(const std::string &file_name, size_t length);
+    //Writes a created file back, false if that fails
+    bool close();
+    char *begin() { return data; }
+    size_t size() { return length; }
+    //Hints that [from, from + count) will be read in no particular order, or read soon
+    void advise_random(size_t from, size_t count);
+    void advise_needed(size_t from, size_t count);
+
+private:
+    char *data;
+    size_t length;
+    bool writable;
+#ifdef _WIN32
+    std::vector<uint64_t> buffer; //uint64_t keeps every section aligned
+    std::string name;
+#endif
+};
+
+#ifdef _WIN32
+inline bool FileMapping::open(const std::string &file_name)
+{
+    close();
+    FILE *in = std::fopen(file_name.c_str(), "rb");
+    if (!in)
+        return false;
+    std::fseek(in, 0, SEEK_END);
+    long end = std::ftell(in);
+    std::fseek(in, 0, SEEK_SET);
+    bool ok = end >= 0;
+    if (ok)
+    {
+        length = end;
+        buffer.assign(length / sizeof(uint64_t) + 1, 0);
+        data = reinterpret_cast<char *>(buffer.data());
+        ok = std::fread(data, 1, length, in) == length;
+    }
+    std::fclose(in);
+    if (!ok)
+        close();
+    return ok;
+}
+inline bool FileMapping::create(const std::string &file_name, size_t size)
+{
+    close();
+    name = file_name;
+    length = size;
+    buffer.assign(length / sizeof(uint64_t) + 1, 0);
+    data = reinterpret_cast<char *>(buffer.data());
+    writable = true;
+    return true;
+}
+inline bool FileMapping::close()
+{
+    bool ok = true;
+    if (data && writable)
+    {
+        FILE *out = std::fopen(name.c_str(), "wb");
+        ok = out && std::fwrite(data, 1, length, out) == length;
+        if (out)
+            ok = std::fclose(out) == 0 && ok;
+    }
+    std::vector<uint64_t>().swap(buffer);
+    data = NULL;
+    length = 0;
+    writable = false;
+    return ok;
+}
+inline void FileMapping::advise_random(size_t, size_t) {}
+inline void FileMapping::advise_needed(size_t, size_t) {}
+#else
+inline bool FileMapping::open(const std::string &file_name)
+{
+    close();
+    int fd = ::open(file_name.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        ::close(fd);
+        return false;
+    }
+    length = st.st_size;
+    void *addr = mmap(NULL, length, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); //The mapping keeps the file open
+    if (addr == MAP_FAILED)
+    {
+        length = 0;
+        return false;
+    }
+    data = static_cast<char *>(addr);
+    return true;
+}
+inline bool FileMapping::create(const std::string &file_name, size_t size)
+{
+    close();
+    int fd = ::open(file_name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return false;
+    if (ftruncate(fd, size) != 0)
+    {
+        ::close(fd);
+        return false;
+    }
+    void *addr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED)
+        return false;
+    data = static_cast<char *>(addr);
+    length = size;
+    writable = true;
+    return true;
+}
+inline bool FileMapping::close()
+{
+    if (!data)
+        return true;
+    bool ok = !writable || msync(data, length, MS_SYNC) == 0;
+    ok = munmap(data, length) == 0 && ok;
+    data = NULL;
+    length = 0;
+    writable = false;
+    return ok;
+}
+inline void FileMapping::advise_random(size_t from, size_t count)
+{
+    //madvise wants a page aligned start
+    size_t page = sysconf(_SC_PAGESIZE), start = from / page * page;
+    if (start < length)
+        madvise(data + start, std::min(length - start, count + from - start), MADV_RANDOM);
+}
+inline void FileMapping::advise_needed(size_t from, size_t count)
+{
+    size_t page = sysconf(_SC_PAGESIZE), start = from / page * page;
+    if (start < length)
+        madvise(data + start, std::min(length - start, count + from - start), MADV_WILLNEED);
+}
+#endif
+
+//A compressed rows file mapped read only, searched like any other storage
+template <typename W>
+class MappedCsrGraph
+{
+public:
+    MappedCsrGraph() : size(0), edge_total(0), largest(0), corrupt(false), first(NULL), edges(NULL) {}
+    MappedCsrGraph(const MappedCsrGraph &) = delete;
+    MappedCsrGraph &operator=(const MappedCsrGraph &) = delete;
+    //False if the file can't be mapped, isn't a compressed rows file, is cut short, holds weights
+    //of another type than W or a max_weight they can't hold. Only the header is read.
+    bool open(const std::string &file_name);
+    //Reads every offset and edge, false for offsets going backwards or past the edges, targets
+    //that aren't vertices or weights outside 0 to max_weight
+    bool check();
+    void close();
+    int get_size() { return size; }
+    size_t edge_count() { return edge_total; }
+    W max_weight() { return largest; }
+    //Whether for_each_edge met an edge like check() rejects, and skipped it
+    bool is_corrupt() { return corrupt; }
+    template <typename F>
+    void for_each_edge(int v, F f)
+    {
+        uint64_t from = first[v], to = first[v + 1];
+        if (from > to || to > edge_total)
+        {
+            corrupt = true;
+            return;
+        }
+        for (uint64_t e = from; e < to; e++)
+        {
+            int32_t target = edges[e].target;
+            W weight = edges[e].weight;
+            if (!valid_edge(target, weight))
+            {
+                corrupt = true;
+                continue;
+            }
+            f(target, weight);
+        }
+    }
+
+private:
+    //Written so that a NaN weight fails too
+    bool valid_edge(int32_t target, W weight) { return target >= 0 && target < size && weight >= 0 && weight <= largest; }
+    FileMapping file;
+    int size;
+    uint64_t edge_total;
+    W largest;
+    bool corrupt;
+    const uint64_t *first;
+    const CsrEdge<W> *edges;
+};
+
+template <typename W>
+bool MappedCsrGraph<W>::open(const std::string &file_name)
+{
+    INSTRUMENT_PHASE("map_graph");
+    close();
+    if (!file.open(file_name) || file.size() < sizeof(CsrFileHeader))
+    {
+        close();
+        return false;
+    }
+    const CsrFileHeader *header = reinterpret_cast<const CsrFileHeader *>(file.begin());
+    if (std::memcmp(header->magic, "CSR1", 4) != 0 || !csr_weights_match<W>(*header) || header->vertices > INT32_MAX ||
+        header->edges > file.size() || file.size() < csr_file_size<W>(header->vertices, header->edges) ||
+        !(header->max_weight >= 0 && header->max_weight <= (double)std::numeric_limits<W>::max()))
+    {
+        close();
+        return false;
+    }
+    size = header->vertices;
+    edge_total = header->edges;
+    //Programs pick their queue by the max_weight of the header, heavier edges are rejected as corrupt.
+    //The largest 64 bit weight rounds up to a double just beyond it.
+    largest = (header->max_weight >= (double)std::numeric_limits<W>::max()) ? std::numeric_limits<W>::max() : (W)header->max_weight;
+    first = reinterpret_cast<const uint64_t *>(header + 1);
+    edges = reinterpret_cast<const CsrEdge<W> *>(first + size + 1);
+    if (first[0] != 0 || first[size] != edge_total)
+    {
+        close();
+        return false;
+    }
+    //The offsets are read for every vertex a search settles, usually in no particular order, and
+    //are small next to the edges, so they are worth reading ahead. The edges of a vertex are
+    //contiguous but the vertices aren't visited in file order, so read ahead there would mostly
+    //bring in pages nobody asks for.
+    size_t edges_at = (const char *)edges - file.begin();
+    file.advise_needed(0, edges_at);
+    file.advise_random(edges_at, file.size() - edges_at);
+    return true;
+}
+
+//One sequential pass over the offsets and the edges, which pulls the whole file through the page cache
+template <typename W>
+bool MappedCsrGraph<W>::check()
+{
+    if (!first || first[0] != 0 || first[size] != edge_total)
+        return false;
+    for (int v = 0; v < size; v++)
+        if (first[v + 1] < first[v])
+            return false;
+    for (uint64_t e = 0; e < edge_total; e++)
+        if (!valid_edge(edges[e].target, edges[e].weight))
+            return false;
+    return true;
+}
+
+template <typename W>
+void MappedCsrGraph<W>::close()
+{
+    file.close();
+    size = 0;
+    edge_total = 0;
+    largest = 0;
+    corrupt = false;
+    first = NULL;
+    edges = NULL;
+}
+
+//Writes a compressed rows file without holding the edges in memory: the file is sized from the
+//degree of every vertex, mapped and each edge written straight into its place as it arrives.
+//
+//    CsrFileWriter<int> out;
+//    out.create("roads.csr", degree);    //degree [v] edges will be added to each v
+//    out.add(u, v, w);                   //In any order
+//    out.close();
+template <typename W>
+class CsrFileWriter
+{
+public:
+    CsrFileWriter() : size(0), largest(0), first(NULL), edges(NULL) {}
+    CsrFileWriter(const CsrFileWriter &) = delete;
+    CsrFileWriter &operator=(const CsrFileWriter &) = delete;
+    ~CsrFileWriter() { close(); }
+    bool create(const std::string &file_name, const std::vector<uint64_t> &degree);
+    //Each vertex must get exactly as many edges as its degree
+    void add(int u, int v, W w)
+    {
+        edges[first[u]++] = {v, w};
+        if (largest < w)
+            largest = w;
+    }
+    bool close();
+
+private:
+    FileMapping file;
+    int size;
+    W largest;
+    uint64_t *first; //While adding, the next free edge of each vertex
+    CsrEdge<W> *edges;
+};
+
+template <typename W>
+bool CsrFileWriter<W>::create(const std::string &file_name, const std::vector<uint64_t> &degree)
+{
+    close();
+    uint64_t n = degree.size(), m = 0;
+    for (uint64_t v = 0; v < n; v++)
+        m += degree[v];
+    if (n > INT32_MAX || !file.create(file_name, csr_file_size<W>(n, m)))
+        return false;
+    CsrFileHeader *header = reinterpret_cast<CsrFileHeader *>(file.begin());
+    std::memcpy(header->magic, "CSR1", 4);
+    header->weight_size = sizeof(W);
+    header->weight_kind = std::is_floating_point<W>::value ? 1 : 0;
+    header->reserved = 0;
+    header->vertices = n;
+    header->edges = m;
+    size = n;
+    largest = 0;
+    first = reinterpret_cast<uint64_t *>(header + 1);
+    edges = reinterpret_cast<CsrEdge<W> *>(first + n + 1);
+    first[0] = 0;
+    for (uint64_t v = 0; v < n; v++)
+        first[v + 1] = first[v] + degree[v];
+    return true;
+}
+
+template <typename W>
+bool CsrFileWriter<W>::close()
+{
+    if (!first)
+        return false;
+    //Every cursor has moved on to where the next vertex starts, shift them back one place
+    for (int v = size; v > 0; v--)
+        first[v] = first[v - 1];
+    first[0] = 0;
+    reinterpret_cast<CsrFileHeader *>(file.begin())->max_weight = largest;
+    first = NULL;
+    edges = NULL;
+    return file.close();
+}
+
+//Writes any graph storage to a compressed rows file
+template <typename W, typename G>
+bool write_csr_file(const std::string &file_name, G &g)
+{
+    int n = g.get_size();
+    std::vector<uint64_t> degree(n, 0);
+    for (int v = 0; v < n; v++)
+        g.for_each_edge(v, [&](int, auto) { degree[v]++; });
+    CsrFileWriter<W> out;
+    if (!out.create(file_name, degree))
+        return false;
+    for (int v = 0; v < n; v++)
+        g.for_each_edge(v, [&](int u, auto w) { out.add(v, u, w); });
+    return out.close();
+}
+
+#endif
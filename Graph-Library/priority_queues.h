@@ -0,0 +1,566 @@
+/*Indexed priority queues shared by the graph algorithms
+
+Every heap is built for vertices 0 .. n-1 and knows where each one sits, so push() both inserts
+a vertex and lowers the priority of one already queued. They all have the same interface:
+
+    explicit Heap(int n);
+    bool is_empty();
+    bool contains(int v);
+    void push(int v, W w);   //Inserts v, or lowers its priority if it's already queued
+    int top();               //Vertex with top priority (least weight)
+    int pop();               //Removes and returns it
+
+so an algorithm takes the heap as a template parameter and the policy is picked at compile time.
+A heap popped until empty can start over with a new search, without being built again.
+*/
+
+#ifndef GRAPH_PRIORITY_QUEUES_H
+#define GRAPH_PRIORITY_QUEUES_H
+
+#include <vector>
+#include <string>
+#include <limits>
+#include <type_traits>
+#include <stdexcept>
+#include "instrumentation.h"
+
+//NODE is a queued vertex and its priority, W is the type of the edge weights
+template <typename W>
+struct NODE
+{
+    int vertex;
+    W weight;
+};
+template <typename W>
+bool operator<(NODE<W> N1, NODE<W> N2) { return N1.weight < N2.weight; }
+
+//Implicit D-ary min heap. A wider node makes the tree shallower, so decreasing a key is cheaper
+//and popping compares more children, which pays off when there are many more pushes than pops.
+template <typename W, int D = 4>
+class DaryHeap
+{
+    static_assert(D >= 2, "A heap node needs at least two children");
+
+public:
+    explicit DaryHeap(int n) : pos(n, -1) {}
+    bool is_empty() { return heap.empty(); }
+    bool contains(int v) { return pos[v] >= 0; }
+    void push(int v, W w)
+    {
+        if (pos[v] < 0)
+        {
+            INSTRUMENT_COUNT(HEAP_PUSHES);
+            pos[v] = heap.size();
+            heap.push_back({v, w});
+        }
+        else if (w < heap[pos[v]].weight)
+        {
+            INSTRUMENT_COUNT(DECREASE_KEYS);
+            heap[pos[v]].weight = w;
+        }
+        else
+            return;
+        sift_up(pos[v]);
+    }
+    int top() { return heap[0].vertex; }
+    int pop()
+    {
+        INSTRUMENT_COUNT(HEAP_POPS);
+        int top = heap[0].vertex;
+        pos[top] = -1;
+        heap[0] = heap.back();
+        heap.pop_back();
+        if (!heap.empty())
+        {
+            pos[heap[0].vertex] = 0;
+            sift_down(0);
+        }
+        return top;
+    }
+
+private:
+    void sift_up(int i)
+    {
+        NODE<W> N = heap[i];
+        while (i > 0 && N < heap[(i - 1) / D])
+        {
+            heap[i] = heap[(i - 1) / D];
+            pos[heap[i].vertex] = i;
+            i = (i - 1) / D;
+        }
+        heap[i] = N;
+        pos[N.vertex] = i;
+    }
+    void sift_down(int i)
+    {
+        NODE<W> N = heap[i];
+        int size = heap.size();
+        while (D * i + 1 < size)
+        {
+            int first = D * i + 1, last = (first + D < size) ? first + D : size;
+            int child = first;
+            for (int c = first + 1; c < last; c++)
+                if (heap[c] < heap[child])
+                    child = c;
+            if (!(heap[child] < N))
+                break;
+            heap[i] = heap[child];
+            pos[heap[i].vertex] = i;
+            i = child;
+        }
+        heap[i] = N;
+        pos[N.vertex] = i;
+    }
+    std::vector<NODE<W>> heap;
+    std::vector<int> pos; //Index of each vertex in heap, -1 if it isn't queued
+};
+
+template <typename W>
+using BinaryHeap = DaryHeap<W, 2>;
+template <typename W>
+using QuaternaryHeap = DaryHeap<W, 4>;
+
+//Radix heap for integer keys that never go below the last key popped, which holds for Dijkstra
+//but not for Prim. Bucket b > 0 holds the keys whose highest bit differing from the last key
+//popped is bit b - 1, so a key only ever moves to lower buckets and each push or pop costs
+//O(log C) amortized for a largest key C, with no comparisons between keys in the same bucket.
+template <typename W>
+class RadixHeap
+{
+    static_assert(std::is_integral<W>::value, "A radix heap needs integer keys");
+    typedef typename std::make_unsigned<W>::type U;
+
+public:
+    explicit RadixHeap(int n) : count(0), last(0), buckets(std::numeric_limits<U>::digits + 1), key(n), bucket(n, -1), slot(n) {}
+    bool is_empty() { return count == 0; }
+    bool contains(int v) { return bucket[v] >= 0; }
+    void push(int v, W w)
+    {
+        if (bucket[v] >= 0)
+        {
+            if (!(w < key[v]))
+                return;
+            INSTRUMENT_COUNT(DECREASE_KEYS);
+            remove(v);
+        }
+        else
+        {
+            INSTRUMENT_COUNT(HEAP_PUSHES);
+            //Once empty, a new search may start below the last key popped
+            if (count++ == 0)
+                last = 0;
+        }
+        key[v] = w;
+        insert(v);
+    }
+    int top()
+    {
+        if (buckets[0].empty())
+            refill();
+        return buckets[0].back();
+    }
+    int pop()
+    {
+        INSTRUMENT_COUNT(HEAP_POPS);
+        int v = top();
+        buckets[0].pop_back();
+        bucket[v] = -1;
+        count--;
+        return v;
+    }
+
+private:
+    int bucket_of(W w)
+    {
+        unsigned long long diff = U(w) ^ U(last);
+        if (diff == 0)
+            return 0;
+#if defined(__GNUC__)
+        return std::numeric_limits<unsigned long long>::digits - __builtin_clzll(diff);
+#else
+        int b = 0;
+        for (; diff != 0; diff >>= 1)
+            b++;
+        return b;
+#endif
+    }
+    void insert(int v)
+    {
+        int b = bucket_of(key[v]);
+        bucket[v] = b;
+        slot[v] = buckets[b].size();
+        buckets[b].push_back(v);
+    }
+    void remove(int v)
+    {
+        std::vector<int> &from = buckets[bucket[v]];
+        int moved = from.back();
+        from[slot[v]] = moved;
+        slot[moved] = slot[v];
+        from.pop_back();
+    }
+    //Moves the first non-empty bucket down once its smallest key becomes the last one popped
+    void refill()
+    {
+        int b = 1;
+        while (buckets[b].empty())
+            b++;
+        std::vector<int> moving;
+        moving.swap(buckets[b]);
+        last = key[moving[0]];
+        for (size_t i = 1; i < moving.size(); i++)
+            if (key[moving[i]] < last)
+                last = key[moving[i]];
+        for (size_t i = 0; i < moving.size(); i++)
+            insert(moving[i]);
+    }
+    int count;
+    W last;
+    std::vector<std::vector<int>> buckets;
+    std::vector<W> key;
+    std::vector<int> bucket; //Bucket of each vertex, -1 if it isn't queued
+    std::vector<int> slot;   //Index of each vertex in its bucket
+};
+
+//Dial's bucket queue: one bucket per key in a circular array, for integer keys that are never
+//further apart than a small span C. That holds for both Dijkstra and Prim when every edge weight
+//is at most C, as a queued distance is at most one edge above the smallest one and a queued
+//Prim key is an edge weight. Pushing is O(1) and popping scans at most C empty buckets, so on
+//small weights it needs neither comparisons nor the log factor of a heap. The array doubles
+//whenever the keys spread wider than it, up to BUCKET_MAX_SPAN buckets: keys spread any wider
+//throw std::length_error rather than allocate a bucket per key, so pick another heap for them.
+const unsigned long long BUCKET_MAX_SPAN = 1 << 20;
+
+template <typename W>
+class BucketQueue
+{
+    static_assert(std::is_integral<W>::value, "A bucket queue needs integer keys");
+
+public:
+    explicit BucketQueue(int n) : count(0), lowest(0), highest(0), buckets(16), key(n), slot(n, -1) {}
+    bool is_empty() { return count == 0; }
+    bool contains(int v) { return slot[v] >= 0; }
+    void push(int v, W w)
+    {
+        if (slot[v] >= 0)
+        {
+            if (!(w < key[v]))
+                return;
+            INSTRUMENT_COUNT(DECREASE_KEYS);
+            remove(v);
+        }
+        else
+        {
+            INSTRUMENT_COUNT(HEAP_PUSHES);
+            if (count++ == 0)
+                lowest = highest = w;
+        }
+        if (w < lowest)
+            lowest = w;
+        if (highest < w)
+            highest = w;
+        key[v] = w;
+        //Every queued key must have a bucket of its own
+        if ((unsigned long long)(highest - lowest) >= buckets.size())
+            grow();
+        insert(v);
+    }
+    int top()
+    {
+        while (buckets[index(lowest)].empty())
+            lowest++;
+        return buckets[index(lowest)].back();
+    }
+    int pop()
+    {
+        INSTRUMENT_COUNT(HEAP_POPS);
+        int v = top();
+        buckets[index(lowest)].pop_back();
+        slot[v] = -1;
+        count--;
+        return v;
+    }
+
+private:
+    size_t index(W w) { return (size_t)w & (buckets.size() - 1); }
+    void insert(int v)
+    {
+        std::vector<int> &to = buckets[index(key[v])];
+        slot[v] = to.size();
+        to.push_back(v);
+    }
+    void remove(int v)
+    {
+        std::vector<int> &from = buckets[index(key[v])];
+        int moved = from.back();
+        from[slot[v]] = moved;
+        slot[moved] = slot[v];
+        from.pop_back();
+    }
+    void grow()
+    {
+        std::vector<int> queued;
+        for (size_t b = 0; b < buckets.size(); b++)
+            queued.insert(queued.end(), buckets[b].begin(), buckets[b].end());
+        if ((unsigned long long)(highest - lowest) >= BUCKET_MAX_SPAN)
+            throw std::length_error("Bucket queue keys spread over more than " + std::to_string(BUCKET_MAX_SPAN) +
+                                    " buckets, the edge weights are too large for it");
+        size_t size = buckets.size();
+        while ((unsigned long long)(highest - lowest) >= size)
+            size *= 2;
+        buckets.assign(size, std::vector<int>());
+        for (size_t i = 0; i < queued.size(); i++)
+            insert(queued[i]);
+    }
+    int count;
+    W lowest, highest; //Bounds of the queued keys, highest may be stale after a pop
+    std::vector<std::vector<int>> buckets;
+    std::vector<W> key;
+    std::vector<int> slot; //Index of each vertex in its bucket, -1 if it isn't queued
+};
+
+//Fibonacci heap with its nodes stored per vertex instead of allocated. Pushing and lowering a
+//priority cost O(1) amortized and popping O(log n), the best bounds of the comparison heaps, although
+//the pointer chasing usually makes it slower than an array heap in practice.
+template <typename W>
+class FibonacciHeap
+{
+public:
+    explicit FibonacciHeap(int n)
+        : min_root(-1), key(n), parent(n, -1), child(n, -1), left(n), right(n), degree(n, 0), marked(n, false), queued(n, false) {}
+    bool is_empty() { return min_root < 0; }
+    bool contains(int v) { return queued[v]; }
+    void push(int v, W w)
+    {
+        if (!queued[v])
+        {
+            INSTRUMENT_COUNT(HEAP_PUSHES);
+            queued[v] = true;
+            key[v] = w;
+            parent[v] = child[v] = -1;
+            degree[v] = 0;
+            marked[v] = false;
+            add_root(v);
+            return;
+        }
+        if (!(w < key[v]))
+            return;
+        INSTRUMENT_COUNT(DECREASE_KEYS);
+        key[v] = w;
+        int p = parent[v];
+        if (p >= 0 && key[v] < key[p])
+        {
+            cut(v);
+            //A vertex that loses a second child is cut too, keeping the trees bushy
+            while (parent[p] >= 0 && marked[p])
+            {
+                int grandparent = parent[p];
+                cut(p);
+                p = grandparent;
+            }
+            if (parent[p] >= 0)
+                marked[p] = true;
+        }
+        if (key[v] < key[min_root])
+            min_root = v;
+    }
+    int top() { return min_root; }
+    int pop()
+    {
+        INSTRUMENT_COUNT(HEAP_POPS);
+        int z = min_root;
+        //Every child of the minimum becomes a root
+        while (child[z] >= 0)
+        {
+            int c = child[z];
+            child[z] = (right[c] == c) ? -1 : right[c];
+            unlink(c);
+            parent[c] = -1;
+            add_root(c);
+        }
+        int next = right[z];
+        unlink(z);
+        queued[z] = false;
+        if (next == z)
+            min_root = -1;
+        else
+        {
+            min_root = next;
+            consolidate();
+        }
+        return z;
+    }
+
+private:
+    void unlink(int v)
+    {
+        right[left[v]] = right[v];
+        left[right[v]] = left[v];
+        left[v] = right[v] = v;
+    }
+    void splice(int v, int list)
+    {
+        left[v] = list;
+        right[v] = right[list];
+        left[right[list]] = v;
+        right[list] = v;
+    }
+    void add_root(int v)
+    {
+        if (min_root < 0)
+        {
+            left[v] = right[v] = v;
+            min_root = v;
+            return;
+        }
+        splice(v, min_root);
+        if (key[v] < key[min_root])
+            min_root = v;
+    }
+    void cut(int v)
+    {
+        int p = parent[v];
+        if (child[p] == v)
+            child[p] = (right[v] == v) ? -1 : right[v];
+        unlink(v);
+        degree[p]--;
+        parent[v] = -1;
+        marked[v] = false;
+        splice(v, min_root);
+    }
+    //Links roots of the same degree until every degree is unique
+    void consolidate()
+    {
+        roots.clear();
+        int v = min_root;
+        do
+        {
+            roots.push_back(v);
+            v = right[v];
+        } while (v != min_root);
+        for (size_t i = 0; i < roots.size(); i++)
+        {
+            int x = roots[i];
+            while (int(by_degree.size()) <= degree[x])
+                by_degree.push_back(-1);
+            while (by_degree[degree[x]] >= 0)
+            {
+                int y = by_degree[degree[x]];
+                by_degree[degree[x]] = -1;
+                if (key[y] < key[x])
+                    std::swap(x, y);
+                //y becomes a child of x
+                unlink(y);
+                if (child[x] < 0)
+                    child[x] = y;
+                else
+                    splice(y, child[x]);
+                parent[y] = x;
+                marked[y] = false;
+                degree[x]++;
+                if (int(by_degree.size()) <= degree[x])
+                    by_degree.push_back(-1);
+            }
+            by_degree[degree[x]] = x;
+        }
+        min_root = -1;
+        for (size_t d = 0; d < by_degree.size(); d++)
+            if (by_degree[d] >= 0)
+            {
+                if (min_root < 0 || key[by_degree[d]] < key[min_root])
+                    min_root = by_degree[d];
+                by_degree[d] = -1;
+            }
+    }
+    int min_root;
+    std::vector<W> key;
+    std::vector<int> parent, child, left, right, degree;
+    std::vector<bool> marked, queued;
+    std::vector<int> roots, by_degree; //Scratch space for consolidate
+};
+
+//The queue the graph algorithms use, with the heap policy as a compile time parameter
+template <typename W, template <typename> class Heap = BinaryHeap>
+using PriorityQueue = Heap<W>;
+
+//Runtime names for the heap policies, so a program can pick one per workload
+enum class HeapPolicy
+{
+    Binary,
+    Dary,
+    Radix,
+    Bucket,
+    Fibonacci
+};
+
+inline bool parse_heap_policy(const std::string &name, HeapPolicy &policy)
+{
+    if (name == "binary")
+        policy = HeapPolicy::Binary;
+    else if (name == "dary")
+        policy = HeapPolicy::Dary;
+    else if (name == "radix")
+        policy = HeapPolicy::Radix;
+    else if (name == "bucket")
+        policy = HeapPolicy::Bucket;
+    else if (name == "fibonacci")
+        policy = HeapPolicy::Fibonacci;
+    else
+        return false;
+    return true;
+}
+
+const long long BUCKET_MAX_WEIGHT = 256; //Largest edge weight for which the bucket queue is picked
+
+//Fastest policy for edge weights of type W up to max_weight. monotone tells whether the keys never
+//go below the last one popped, which holds for Dijkstra but not for Prim. Below BUCKET_MAX_WEIGHT
+//the buckets beat every heap, above it the empty buckets cost more than the radix heap's moves.
+//max_weight must be the largest weight the graph actually holds, not a guess: the bucket queue
+//needs as many buckets as that, and throws once it would need more than BUCKET_MAX_SPAN.
+template <typename W>
+HeapPolicy fastest_heap(W max_weight, bool monotone)
+{
+    if (std::is_integral<W>::value && max_weight <= BUCKET_MAX_WEIGHT)
+        return HeapPolicy::Bucket;
+    if (std::is_integral<W>::value && monotone)
+        return HeapPolicy::Radix;
+    return HeapPolicy::Dary;
+}
+
+template <typename Queue>
+struct HeapTag
+{
+    typedef Queue type;
+};
+
+//Calls visit(HeapTag<Queue>()) with the queue type of the policy, so the algorithm behind visit
+//is compiled once per policy. Radix and bucket fall back to the D-ary heap for floating point weights.
+template <typename W, typename Visit>
+void with_heap(HeapPolicy policy, Visit visit)
+{
+    switch (policy)
+    {
+    case HeapPolicy::Binary:
+        visit(HeapTag<PriorityQueue<W, BinaryHeap>>());
+        break;
+    case HeapPolicy::Radix:
+    case HeapPolicy::Bucket:
+        if constexpr (std::is_integral<W>::value)
+        {
+            if (policy == HeapPolicy::Radix)
+                visit(HeapTag<PriorityQueue<W, RadixHeap>>());
+            else
+                visit(HeapTag<PriorityQueue<W, BucketQueue>>());
+            break;
+        }
+        [[fallthrough]];
+    case HeapPolicy::Dary:
+        visit(HeapTag<PriorityQueue<W, QuaternaryHeap>>());
+        break;
+    case HeapPolicy::Fibonacci:
+        visit(HeapTag<PriorityQueue<W, FibonacciHeap>>());
+        break;
+    }
+}
+
+#endif
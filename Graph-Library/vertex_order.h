@@ -0,0 +1,176 @@
+/*Renumbering vertices so that neighbours get nearby numbers
+
+A search reads dist, parent and the edges of every vertex it reaches, in the order the input
+happened to number them. After renumbering, the vertices a search reaches one after another sit
+next to each other in those arrays, so far fewer cache lines are touched:
+
+    Renumbering r(g, VertexOrder::CuthillMcKee);
+    CsrGraph<int> h = r.apply<int>(g);
+    dijkstra_search<Queue>(h, r.to_new(src), dist, parent);
+    dist = r.restore(dist);             //Indexed by the original numbers again
+    parent = r.restore_ids(parent);     //And holding them
+*/
+
+#ifndef GRAPH_VERTEX_ORDER_H
+#define GRAPH_VERTEX_ORDER_H
+
+#include <vector>
+#include <string>
+#include <numeric>
+#include <algorithm>
+#include "graph_storage.h"
+
+enum class VertexOrder
+{
+    Input,        //As numbered in the input
+    Bfs,          //Breadth first from the start vertex
+    CuthillMcKee, //Reverse Cuthill-McKee: breadth first, lowest degree neighbours first, reversed
+    Degree        //Highest degree first
+};
+
+//Reads "input", "bfs", "rcm" or "degree", false for anything else
+inline bool parse_vertex_order(const std::string &name, VertexOrder &order)
+{
+    if (name == "input")
+        order = VertexOrder::Input;
+    else if (name == "bfs")
+        order = VertexOrder::Bfs;
+    else if (name == "rcm")
+        order = VertexOrder::CuthillMcKee;
+    else if (name == "degree")
+        order = VertexOrder::Degree;
+    else
+        return false;
+    return true;
+}
+
+class Renumbering
+{
+public:
+    //Orders the vertices of g, the breadth first orders start at start
+    template <typename G>
+    Renumbering(G &g, VertexOrder order, int start = 0);
+    int get_size() { return old_id.size(); }
+    int to_new(int v) { return new_id[v]; }
+    int to_old(int v) { return old_id[v]; }
+    //Copies g to compressed rows in the new numbers
+    template <typename W, typename G>
+    CsrGraph<W> apply(G &g);
+    //Values indexed by the new numbers, reindexed by the original ones
+    template <typename T>
+    std::vector<T> restore(const std::vector<T> &values);
+    //As restore, for values that are vertices too, e.g. parents. -1 stays -1.
+    std::vector<int> restore_ids(const std::vector<int> &ids);
+
+private:
+    std::vector<int> old_id; //Original number of each new one
+    std::vector<int> new_id; //New number of each original one
+};
+
+//g seen through the new numbers, so it can be copied without an edge list in between
+template <typename G>
+class RenumberedGraph
+{
+public:
+    RenumberedGraph(G &graph, Renumbering &r) : g(graph), renumbering(r) {}
+    int get_size() { return g.get_size(); }
+    template <typename F>
+    void for_each_edge(int v, F f)
+    {
+        g.for_each_edge(renumbering.to_old(v), [&](int u, auto w) { f(renumbering.to_new(u), w); });
+    }
+
+private:
+    G &g;
+    Renumbering &renumbering;
+};
+
+template <typename G>
+Renumbering::Renumbering(G &g, VertexOrder order, int start)
+{
+    int n = g.get_size();
+    std::vector<int> degree;
+    if (order == VertexOrder::CuthillMcKee || order == VertexOrder::Degree)
+    {
+        degree.assign(n, 0);
+        for (int v = 0; v < n; v++)
+            g.for_each_edge(v, [&](int, auto) { degree[v]++; });
+    }
+    auto lower_degree = [&](int a, int b) { return degree[a] < degree[b]; };
+
+    if (order == VertexOrder::Input || order == VertexOrder::Degree)
+    {
+        old_id.resize(n);
+        std::iota(old_id.begin(), old_id.end(), 0);
+        //The hubs most searches pass through end up next to each other
+        if (order == VertexOrder::Degree)
+            std::stable_sort(old_id.begin(), old_id.end(), [&](int a, int b) { return degree[a] > degree[b]; });
+    }
+    else
+    {
+        //Breadth first from start, then from the first vertex left of every other component.
+        //Cuthill-McKee starts those at their lowest degree vertex and queues the neighbours
+        //of each vertex by increasing degree.
+        bool cuthill_mckee = order == VertexOrder::CuthillMcKee;
+        std::vector<int> roots(n);
+        std::iota(roots.begin(), roots.end(), 0);
+        if (cuthill_mckee)
+            std::stable_sort(roots.begin(), roots.end(), lower_degree);
+        std::vector<bool> seen(n, false);
+        old_id.reserve(n);
+        for (int i = -1; i < n; i++)
+        {
+            int root = (i < 0) ? start : roots[i];
+            if (root < 0 || root >= n || seen[root])
+                continue;
+            seen[root] = true;
+            old_id.push_back(root);
+            //old_id doubles as the queue
+            for (size_t head = old_id.size() - 1; head < old_id.size(); head++)
+            {
+                size_t first = old_id.size();
+                g.for_each_edge(old_id[head], [&](int v, auto) {
+                    if (!seen[v])
+                    {
+                        seen[v] = true;
+                        old_id.push_back(v);
+                    }
+                });
+                if (cuthill_mckee)
+                    std::stable_sort(old_id.begin() + first, old_id.end(), lower_degree);
+            }
+        }
+        //Reversing gives a smaller profile than Cuthill-McKee itself
+        if (cuthill_mckee)
+            std::reverse(old_id.begin(), old_id.end());
+    }
+    new_id.resize(n);
+    for (int v = 0; v < n; v++)
+        new_id[old_id[v]] = v;
+}
+
+template <typename W, typename G>
+CsrGraph<W> Renumbering::apply(G &g)
+{
+    RenumberedGraph<G> renumbered(g, *this);
+    return CsrGraph<W>::from_graph(renumbered);
+}
+
+template <typename T>
+std::vector<T> Renumbering::restore(const std::vector<T> &values)
+{
+    std::vector<T> restored(values.size());
+    for (size_t v = 0; v < values.size(); v++)
+        restored[old_id[v]] = values[v];
+    return restored;
+}
+
+inline std::vector<int> Renumbering::restore_ids(const std::vector<int> &ids)
+{
+    std::vector<int> restored(ids.size());
+    for (size_t v = 0; v < ids.size(); v++)
+        restored[old_id[v]] = (ids[v] < 0) ? ids[v] : old_id[ids[v]];
+    return restored;
+}
+
+#endif
@@ -5,210 +5,291 @@
                     Omar Safwat
 */
 
-#include <iostream>
-#include <vector>
-#include <fstream>
-#include <iterator>
-#include <limits>
-#include <numeric>
-using namespace std;
+#include "Prim_matrix.h"
 
-const int INF_DIST = numeric_limits<int>::max(); //Infinite distance
-
-typedef struct NODE
+//Whether arg names a tree file rather than a vertex
+bool is_file_name(const char *arg)
 {
-    int vertex;
-    int weight;
-} NODE;
-bool operator<(NODE N1, NODE N2) { return (N1.weight < N2.weight ? true : false); }
+    return string(arg).find_first_not_of("0123456789") != string::npos;
+}
 
-void heapify(vector<NODE> &pq, int size, int root)
+//Prints the path of path_vertex up to the root and the lowest common ancestor of lca_u and lca_v,
+//each only if it was asked for with vertices in the tree
+void print_queries(SpanningTree &tree, int path_vertex, int lca_u, int lca_v)
 {
-    int smallest = root;
-    int l = 2 * root + 1;
-    int r = 2 * root + 2;
-
-    // if left child is smaller than root
-    if (l < size && pq[l] < pq[smallest])
-        smallest = l;
-
-    // if right child is smaller than smallest so far
-    if (r < size && pq[r] < pq[smallest])
-        smallest = r;
-
-    if (smallest != root)
+    if (path_vertex >= 0 && path_vertex < tree.get_size())
     {
-        swap(pq[root], pq[smallest]);
-
-        // recursively heapify the affected sub-tree
-        heapify(pq, size, smallest);
+        vector<int> path = tree.path(path_vertex);
+        if (path.empty())
+            cout << path_vertex << " isn't connected to the tree" << endl;
+        else
+        {
+            cout << path.back();
+            for (int j = (int)path.size() - 2; j >= 0; j--)
+                cout << "<-" << path[j];
+            cout << endl;
+        }
     }
-}
-
-void heapSort(vector<NODE> &pq)
-{
-    int size = pq.size();
-    //Builds a heap (rearrange).
-    for (int root = size / 2 - 1; root >= 0; root--)
-        heapify(pq, size, root);
-
-    for (int i = size - 1; i > 0; i--)
+    if (lca_u >= 0 && lca_v >= 0 && lca_u < tree.get_size() && lca_v < tree.get_size())
     {
-        //Moves the smallest vertex (At the root, pq[0]) to the end of the array (Bottom right corner of heap).
-        swap(pq[0], pq[i]);
-        //Moves the next smallest vertex to the root, to repeat the above step.
-        heapify(pq, i, 0);
+        TreeAnalytics analytics(tree);
+        int ancestor = analytics.lca(lca_u, lca_v);
+        if (ancestor < 0)
+            cout << lca_u << " and " << lca_v << " aren't in the same tree" << endl;
+        else
+            cout << "LCA = " << ancestor << ", path cost = " << analytics.path_cost(lca_u, lca_v) << endl;
     }
 }
 
-class PriorityQueue
-{
-public:
-    explicit PriorityQueue(int n);
-    void insert(NODE N) { pq.push_back(N); }
-    void sort_queue() { heapSort(pq); }
-    int top() { return pq.back().vertex; } // returns vetrex with top priority
-    void pop_queue() { pq.pop_back(); }
-    void chgPriority(int v, int w);
-    void print_queue()
-    {
-        cout << "My Queue is:\n";
-        for (int i = 0; i < pq.size(); i++)
-            cout << pq[i].weight << "\t\t";
-    }
-    bool is_empty() { return pq.empty(); }
-
-private:
-    vector<NODE> pq;
-};
-
-PriorityQueue::PriorityQueue(int n)
-{
-    for (int i = 1; i < n; i++)
-        insert({i, INF_DIST});
-    insert({0, 0});
-}
-void PriorityQueue::chgPriority(int v, int w)
-{
-    int i = 0;
-    //Looks for the element in Queue with this vertex ID.
-    while (pq[i].vertex != v)
-        i++;
-    //Update nodes weight.
-    pq[i].weight = w;
-}
-
-class Graph
+int main(int argc, char *argv[])
 {
-public:
-    explicit Graph(ifstream &my_file);
-    vector<int> get_edges(int row) { return adj[row]; }
-    int get_size() { return size; }
-    void print_graph();
-
-private:
-    int size;
-    vector<vector<int>> adj; //2D vector to store edges
-};
-
-Graph::Graph(ifstream &my_file)
-{
-    my_file >> size;    //Size of graph is always the first int written in the file
-    for (int i = 0; i < size; i++)
+    //Usage: Prim_matrix [graph file] [--export <file>] [--path [tree file] <vertex>] [--threads <n>] [--convert <file>] [--mode <mode>] [--algo <algo>] [--weight-bits <bits>] [--updates <file>] [--lca [tree file] <u> <v>] [--heap <heap>] [--order <order>] [--bench-heaps]
+    //--export writes the whole tree instead of printing every path, as text if the file ends in .csv
+    //and in the binary format otherwise. --path prints the path from one vertex up to the root.
+    //Given a tree file written by --export in the binary format, --path and --lca load that tree
+    //and answer from it without reading the graph or computing the tree again.
+    //--threads sets how many threads parse a text graph file, --convert saves the graph as a binary edge list.
+    //--algo prim|kruskal|boruvka picks the MST algorithm, --threads also sets how many threads Kruskal and
+    //Boruvka use. --mode dense|sparse picks the V x V matrix or the sparse graph for Prim. The matrix
+    //stores 0 for a missing edge, so only the sparse graph, Kruskal and Boruvka keep edges of weight 0.
+    //By default dense graphs use Prim on the matrix, sparse ones Boruvka, or Kruskal with a single core.
+    //--weight-bits 16|32 sets the size of the matrix weights, by default 16 if every weight fits.
+    //--updates applies a file of "U V Distance" edge changes to the tree without recomputing it,
+    //a distance of 0 deletes the edge. --lca prints the lowest common ancestor of two vertices and
+    //the cost of the tree path between them. --heap binary|dary|bucket|fibonacci runs Prim with a queue from
+    //the graph library, and on the matrix instead of the array scan. Sparse graphs use the bucket queue by
+    //default when every weight is small, the 4-ary heap otherwise. --order bfs|rcm|degree renumbers
+    //the vertices of the sparse graph so that Prim's scans stay close together in memory, the output
+    //still uses the input numbers. It picks sparse Prim unless --mode or --algo say otherwise.
+    //--bench-heaps times every queue and order.
+    string graph_file = "week4_hw.txt", tree_file, export_file, convert_file, updates_file, heap, mode = "auto", algo = "auto", order_name;
+    int path_vertex = -1, lca_u = -1, lca_v = -1;
+    unsigned threads = 0;
+    int weight_bits = 0;
+    bool bench_heaps = false, graph_given = false;
+    const char *usage = "Usage: prim [graph file] [--export <file>] [--path [tree file] <vertex>] [--threads <n>] [--convert <file>] [--mode auto|dense|sparse]\n"
+                        "            [--algo auto|prim|kruskal|boruvka] [--weight-bits 16|32] [--updates <file>]\n"
+                        "            [--lca [tree file] <u> <v>] [--heap binary|dary|bucket|fibonacci] [--order input|bfs|rcm|degree] [--bench-heaps]";
+    for (int i = 1; i < argc; i++)
     {
-        adj.push_back(vector<int>(size, 0));
+        string arg = argv[i];
+        //Only the first argument that isn't an option is the graph file, anything else is a mistake
+        bool bad = false;
+        try
+        {
+            if (arg == "--export" && i + 1 < argc)
+                export_file = argv[++i];
+            else if ((arg == "--path" || arg == "--lca") && i + 1 < argc && is_file_name(argv[i + 1]))
+            {
+                //One tree file answers every query, so naming two different ones is a mistake
+                bad = !tree_file.empty() && tree_file != argv[i + 1];
+                tree_file = argv[++i];
+                if (arg == "--path" && i + 1 < argc)
+                    path_vertex = stoi(argv[++i]);
+                else if (arg == "--lca" && i + 2 < argc)
+                {
+                    lca_u = stoi(argv[++i]);
+                    lca_v = stoi(argv[++i]);
+                }
+                else
+                    bad = true;
+            }
+            else if (arg == "--path" && i + 1 < argc)
+                path_vertex = stoi(argv[++i]);
+            else if (arg == "--lca" && i + 2 < argc)
+            {
+                lca_u = stoi(argv[++i]);
+                lca_v = stoi(argv[++i]);
+            }
+            else if (arg == "--threads" && i + 1 < argc)
+                threads = stoi(argv[++i]);
+            else if (arg == "--convert" && i + 1 < argc)
+                convert_file = argv[++i];
+            else if (arg == "--mode" && i + 1 < argc)
+                mode = argv[++i];
+            else if (arg == "--algo" && i + 1 < argc)
+                algo = argv[++i];
+            else if (arg == "--weight-bits" && i + 1 < argc)
+                weight_bits = stoi(argv[++i]);
+            else if (arg == "--updates" && i + 1 < argc)
+                updates_file = argv[++i];
+            else if (arg == "--heap" && i + 1 < argc)
+                heap = argv[++i];
+            else if (arg == "--order" && i + 1 < argc)
+                order_name = argv[++i];
+            else if (arg == "--bench-heaps")
+                bench_heaps = true;
+            else if (arg.compare(0, 2, "--") != 0 && !graph_given)
+            {
+                graph_file = arg;
+                graph_given = true;
+            }
+            else
+                bad = true;
+        }
+        catch (const logic_error &)
+        {
+            bad = true; //stoi found no number, or one too large for an int
+        }
+        if (bad)
+        {
+            cout << "Unexpected argument " << arg << "\n" << usage << endl;
+            return 1;
+        }
     }
-    int row, col, dist;
-    //Reading the edges from file written in this order: U V Distance.
-    while (my_file)
+    if (mode != "auto" && mode != "dense" && mode != "sparse")
     {
-        my_file >> row;
-        my_file >> col;
-        my_file >> dist;
-        adj[row][col] = dist;
+        cout << "Unknown mode " << mode << ", expected auto, dense or sparse" << endl;
+        return 1;
     }
-    my_file.close();
-}
-void Graph::print_graph()
-{
-    for (auto i = adj.begin(); i != adj.end(); i++)
+    if (algo != "auto" && algo != "prim" && algo != "kruskal" && algo != "boruvka")
     {
-        for (auto j = (*i).begin(); j != (*i).end(); j++)
+        cout << "Unknown algorithm " << algo << ", expected auto, prim, kruskal or boruvka" << endl;
+        return 1;
+    }
+    if (weight_bits != 0 && weight_bits != 16 && weight_bits != 32)
+    {
+        cout << "Unknown weight size " << weight_bits << ", expected 16 or 32" << endl;
+        return 1;
+    }
+    if (!tree_file.empty())
+    {
+        SpanningTree tree;
+        if (!tree.load(tree_file))
         {
-            cout << *j << "\t";
+            cout << "Failed to read the tree in " << tree_file << endl;
+            return 1;
         }
-        cout << endl;
+        print_queries(tree, path_vertex, lca_u, lca_v);
+        return 0;
     }
-}
 
-void update_adjNodes(Graph &g, PriorityQueue &PQ, vector<bool> &visited, vector<int> &parent, vector<int> &min_dist)
-{
-    int top = PQ.top();                   //top is the vertex with top priority (least weight)
-    visited[top] = true;
-    PQ.pop_queue();
-    vector<int> edges = g.get_edges(top); //A vector containing the data of neighbouring nodes
-    int v = 0;
-    for (auto i = edges.begin(); i != edges.end(); i++, v++)
-    {
-        //Updating distance values
-        if (*i > 0 && visited[v] == false && *i < min_dist[v])
+    int size;
+    vector<EDGE> edges;
+    if (!load_edges(graph_file, size, edges, threads))
+    {
+        cout << "File has failed to open" << endl;
+        return 0;
+    }
+    if (weight_bits == 16 && !fits_16_bits(edges))
+    {
+        cout << "--weight-bits 16 needs every weight between 0 and " << numeric_limits<uint16_t>::max() << endl;
+        return 1;
+    }
+    if (!convert_file.empty())
+    {
+        if (!save_edges(convert_file, size, edges))
         {
-            min_dist[v] = *i;
-            parent[v] = top;
-            PQ.chgPriority(v, *i);
+            cout << "Failed to write " << convert_file << endl;
+            return 1;
         }
+        return 0;
     }
-    PQ.sort_queue();
-}
-
-void prim_algo(Graph &g)
-{
-    int n = g.get_size();
-    vector<int> min_dist(n, INF_DIST); //To store the shortest edge for each node
-    min_dist[0] = 0;
-    vector<bool> visited(n, false);
-    visited[0] = true;
-    vector<int> parent(n);             //To save the path with the least cost
-    parent[0] = 0;
-    PriorityQueue PQ(n);
-    vector<int> cost(n, 0);
-
-    while (!PQ.is_empty())
-        update_adjNodes(g, PQ, visited, parent, min_dist);
+    if (bench_heaps)
+    {
+        SparseGraph g(size, edges);
+        benchmark_heaps(g);
+        return 0;
+    }
+    HeapPolicy policy = fastest_heap(max_weight(edges), false);
+    if (!heap.empty() && !parse_heap_policy(heap, policy))
+    {
+        cout << "Unknown heap " << heap << ", expected binary, dary, bucket or fibonacci" << endl;
+        return 1;
+    }
+    if (policy == HeapPolicy::Radix)
+    {
+        //Prim's keys are edge weights, which don't grow as the tree does
+        cout << "Prim's algorithm can't use the radix heap" << endl;
+        return 1;
+    }
+    VertexOrder order = VertexOrder::Input;
+    if (!order_name.empty() && !parse_vertex_order(order_name, order))
+    {
+        cout << "Unknown vertex order " << order_name << ", expected input, bfs, rcm or degree" << endl;
+        return 1;
+    }
+    bool dense = edges.size() >= DENSE_THRESHOLD * size * size;
+    bool reorder = order != VertexOrder::Input;
+    if (mode == "auto")
+        mode = (dense && !reorder) ? "dense" : "sparse";
+    if (algo == "auto")
+        algo = (dense || reorder) ? "prim" : (thread_count(threads) > 1 ? "boruvka" : "kruskal");
 
-    cout << "Printing out the path to each vertex:\n\n";
-    for (int i = 0; i < parent.size(); i++)
+    SpanningTree tree;
+    if (algo == "kruskal")
+        tree = kruskal(size, edges, threads);
+    else if (algo == "boruvka")
+        tree = boruvka(size, edges, threads);
+    else if (mode == "dense" && !heap.empty())
     {
-        cout << i;
-        int my_parent = parent[i];
-        cost[i] = min_dist[i];
-        while (my_parent > 0)
+        Graph<int> g(size, edges);
+        try
+        {
+            with_heap<int>(policy, [&](auto tag) { tree = prim_tree<typename decltype(tag)::type>(g); });
+        }
+        catch (const length_error &e)
         {
-            cout << "<-" << my_parent;
-            cost[i] += min_dist[my_parent];
-            my_parent = parent[my_parent];
+            cout << e.what() << endl;
+            return 1;
         }
-        cout << "<-0\n\n";
     }
-    cout << "Vertex\t\tCost to this node\n\n";  
-    int node = 0;
-    for (auto iter = cost.begin(); iter != cost.end(); node++, iter++)
-        cout << node << "\t\t" << *iter << endl;
-    cout << endl << "Cost of tree = " << accumulate(min_dist.begin(), min_dist.end(), 0) << endl;
-}
-
-int main()
-{
-    ifstream my_file("week4_hw.txt");
-    if (my_file.is_open())
+    else if (mode == "dense")
     {
-        Graph g(my_file);
-        //g.print_graph();
-        prim_algo(g);
+        //16 bit weights halve the matrix whenever they're wide enough
+        if (weight_bits == 16 || (weight_bits == 0 && fits_16_bits(edges)))
+            tree = dense_tree<uint16_t>(size, edges);
+        else
+            tree = dense_tree<int>(size, edges);
     }
     else
     {
-        cout << "File has failed to open" << endl;
+        SparseGraph g(size, edges);
+        if (updates_file.empty())
+            vector<EDGE>().swap(edges); //The sparse graph holds its own copy
+        try
+        {
+            with_heap<int>(policy, [&](auto tag) { tree = prim_sparse<typename decltype(tag)::type>(g, order); });
+        }
+        catch (const length_error &e)
+        {
+            cout << e.what() << endl;
+            return 1;
+        }
     }
+    if (!updates_file.empty())
+    {
+        MappedFile file(updates_file);
+        if (!file.is_open())
+        {
+            cout << "Failed to open " << updates_file << endl;
+            return 1;
+        }
+        vector<int> ints;
+        parse_ints(file.begin(), file.end(), ints);
+        DynamicMST dynamic(tree, edges);
+        INSTRUMENT_PHASE("dynamic_updates");
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (size_t i = 0; i + 2 < ints.size(); i += 3)
+            dynamic.set_edge(ints[i], ints[i + 1], ints[i + 2]);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        cout << "Applied " << ints.size() / 3 << " updates in " << ms << " ms, cost of tree = " << dynamic.tree_cost() << "\n\n";
+        tree = dynamic.get_tree();
+    }
+    if (export_file.empty() && path_vertex < 0 && lca_u < 0)
+    {
+        print_tree(tree);
+        return 0;
+    }
+    if (!export_file.empty())
+    {
+        bool csv = export_file.size() >= 4 && export_file.compare(export_file.size() - 4, 4, ".csv") == 0;
+        if (!(csv ? tree.export_csv(export_file) : tree.save(export_file)))
+        {
+            cout << "Failed to write " << export_file << endl;
+            return 1;
+        }
+    }
+    print_queries(tree, path_vertex, lca_u, lca_v);
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,1386 @@
+/*Reads a graph from a file and finds Minimum spanning using Prim's Algorithm
+
+                    8th November 2020
+
+                    Omar Safwat
+*/
+
+//Graph storage, loaders and spanning tree algorithms, shared by the program and its benchmarks
+#ifndef PRIM_MATRIX_H
+#define PRIM_MATRIX_H
+
+#include <iostream>
+#include <vector>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <chrono>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+#ifdef _WIN32
+#include <sstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "../Graph-Library/graph_algorithms.h"
+#include "../Graph-Library/vertex_order.h"
+#include "../Graph-Library/csv_writer.h"
+using namespace std;
+
+const int INF_DIST = numeric_limits<int>::max(); //Infinite distance
+const double DENSE_THRESHOLD = 0.25;             //Edge density (edges / V^2) from which the V x V matrix is used
+const size_t MIN_EDGES_PER_THREAD = 1 << 16;     //Smaller edge lists aren't worth splitting
+const int SIMD_BYTES = 32;                       //Matrix rows are aligned and padded to one AVX2 register
+
+//An edge as read from a graph file
+typedef struct EDGE
+{
+    int u;
+    int v;
+    int weight;
+} EDGE;
+
+//Read-only view of a whole file. It's memory mapped where the platform allows it,
+//so the parser reads straight out of the page cache without copying into a stream buffer.
+class MappedFile
+{
+public:
+    explicit MappedFile(const string &file_name);
+    ~MappedFile();
+    bool is_open() { return opened; }
+    const char *begin() { return data; }
+    const char *end() { return data + length; }
+    size_t size() { return length; }
+
+private:
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    bool opened = false;
+    const char *data = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    string contents;
+#endif
+};
+
+#ifdef _WIN32
+inline MappedFile::MappedFile(const string &file_name)
+{
+    ifstream in(file_name, ios::binary);
+    if (!in.is_open())
+        return;
+    ostringstream buffer;
+    buffer << in.rdbuf();
+    contents = buffer.str();
+    data = contents.data();
+    length = contents.size();
+    opened = true;
+}
+inline MappedFile::~MappedFile() {}
+#else
+inline MappedFile::MappedFile(const string &file_name)
+{
+    int fd = open(file_name.c_str(), O_RDONLY);
+    if (fd < 0)
+        return;
+    struct stat info;
+    if (fstat(fd, &info) == 0)
+    {
+        length = info.st_size;
+        if (length == 0)
+            opened = true;
+        else
+        {
+            void *addr = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED)
+            {
+                madvise(addr, length, MADV_SEQUENTIAL);
+                data = static_cast<const char *>(addr);
+                opened = true;
+            }
+        }
+    }
+    close(fd);
+}
+inline MappedFile::~MappedFile()
+{
+    if (data != nullptr)
+        munmap(const_cast<char *>(data), length);
+}
+#endif
+
+//Appends every integer in [first, last) to out, anything else acts as a separator
+inline void parse_ints(const char *first, const char *last, vector<int> &out)
+{
+    while (first < last)
+    {
+        while (first < last && (*first < '0' || *first > '9') && *first != '-')
+            first++;
+        if (first == last)
+            break;
+        int value;
+        from_chars_result res = from_chars(first, last, value);
+        if (res.ec != errc())
+        {
+            first++;
+            continue;
+        }
+        out.push_back(value);
+        first = res.ptr;
+    }
+}
+
+const size_t MIN_BYTES_PER_THREAD = 1 << 20; //Smaller files aren't worth splitting
+const char EDGE_MAGIC[4] = {'E', 'D', 'G', '1'};
+
+//Binary edge list: "EDG1", vertex count (int32), edge count (int64), then U V Distance (int32 each) per edge
+inline bool save_edges(const string &file_name, int size, const vector<EDGE> &edges)
+{
+    ofstream out(file_name, ios::binary);
+    if (!out.is_open())
+        return false;
+    long long count = edges.size();
+    out.write(EDGE_MAGIC, 4);
+    out.write(reinterpret_cast<const char *>(&size), sizeof(int));
+    out.write(reinterpret_cast<const char *>(&count), sizeof(long long));
+    out.write(reinterpret_cast<const char *>(edges.data()), count * sizeof(EDGE));
+    return out.good();
+}
+
+//Loads a graph file, either the binary edge list or text with the number of vertices first and then
+//U V Distance for every edge. Text is split into chunks parsed on separate threads, threads = 0 uses
+//every core. Fails if the file can't be read or an edge names a vertex that doesn't exist.
+inline bool load_edges(const string &file_name, int &size, vector<EDGE> &edges, unsigned threads = 0)
+{
+    INSTRUMENT_PHASE("load_edges");
+    MappedFile file(file_name);
+    if (!file.is_open())
+        return false;
+    edges.clear();
+
+    const size_t header = 4 + sizeof(int) + sizeof(long long);
+    if (file.size() >= header && memcmp(file.begin(), EDGE_MAGIC, 4) == 0)
+    {
+        long long count;
+        memcpy(&size, file.begin() + 4, sizeof(int));
+        memcpy(&count, file.begin() + 4 + sizeof(int), sizeof(long long));
+        if (count < 0 || file.size() < header + count * sizeof(EDGE))
+            return false;
+        edges.resize(count);
+        memcpy(edges.data(), file.begin() + header, count * sizeof(EDGE));
+    }
+    else
+    {
+        if (threads == 0)
+            threads = max(1u, thread::hardware_concurrency());
+        threads = min<size_t>(threads, file.size() / MIN_BYTES_PER_THREAD + 1);
+
+        //Chunk boundaries are moved forward to the next separator so no number is cut in two
+        vector<const char *> bounds(threads + 1, file.end());
+        bounds[0] = file.begin();
+        for (unsigned t = 1; t < threads; t++)
+        {
+            const char *b = max(bounds[t - 1], file.begin() + file.size() / threads * t);
+            while (b < file.end() && ((*b >= '0' && *b <= '9') || *b == '-'))
+                b++;
+            bounds[t] = b;
+        }
+        vector<vector<int>> ints(threads);
+        vector<thread> workers;
+        for (unsigned t = 1; t < threads; t++)
+            workers.emplace_back(parse_ints, bounds[t], bounds[t + 1], ref(ints[t]));
+        parse_ints(bounds[0], bounds[1], ints[0]);
+        for (unsigned t = 0; t < workers.size(); t++)
+            workers[t].join();
+
+        //Size of graph is always the first int written in the file, a trailing incomplete edge is dropped
+        long long total = 0;
+        for (unsigned t = 0; t < threads; t++)
+            total += ints[t].size();
+        if (total == 0)
+            return false;
+        size = ints[0][0];
+        edges.resize((total - 1) / 3);
+        long long k = -1; //Position of the next int among all chunks, -1 being the size
+        for (unsigned t = 0; t < threads; t++)
+            for (size_t i = 0; i < ints[t].size(); i++, k++)
+                if (k >= 0 && k / 3 < (long long)edges.size())
+                    (&edges[k / 3].u)[k % 3] = ints[t][i];
+    }
+
+    if (size < 0)
+        return false;
+    for (size_t i = 0; i < edges.size(); i++)
+        if (edges[i].u < 0 || edges[i].u >= size || edges[i].v < 0 || edges[i].v >= size)
+            return false;
+    return true;
+}
+
+//Read-only view of a matrix row, it points into the matrix instead of copying the row
+template <typename T>
+class RowView
+{
+public:
+    RowView(const T *d, int n) : first(d), count(n) {}
+    const T *begin() const { return first; }
+    const T *end() const { return first + count; }
+    int size() const { return count; }
+    T operator[](int i) const { return first[i]; }
+
+private:
+    const T *first;
+    int count;
+};
+
+//Adjacency matrix in one contiguous row-major block instead of a separate allocation per row.
+//Each row starts on a SIMD_BYTES boundary and is padded with zeros (no edge) up to the next one,
+//so vector loads are aligned and may run past the last vertex. T is the weight type: int, or
+//uint16_t to halve the memory and bandwidth of the matrix when every weight fits.
+template <typename T = int>
+class Graph
+{
+public:
+    //Both throw out_of_range for an edge naming a vertex that doesn't exist or a weight T can't hold
+    explicit Graph(ifstream &my_file);
+    Graph(int n, const vector<EDGE> &edges);
+    RowView<T> get_edges(int row) { return RowView<T>(row_data(row), size); }
+    const T *row_data(int row) { return base + (size_t)row * stride; }
+    int get_size() { return size; }
+    int get_stride() { return stride; } //Row length including the padding
+    void print_graph();
+    //Calls f(vertex, weight) for each edge of row, skipping the zeros that mean no edge
+    template <typename F>
+    void for_each_edge(int row, F f)
+    {
+        const T *w = row_data(row);
+        for (int v = 0; v < size; v++)
+            if (w[v] > 0)
+                f(v, (int)w[v]);
+    }
+
+private:
+    Graph(const Graph &) = delete;
+    Graph &operator=(const Graph &) = delete;
+    void allocate(int n);
+    T &at(int row, int col) { return base[(size_t)row * stride + col]; }
+    static T checked_weight(int weight);
+
+    int size;
+    int stride;
+    vector<T> storage; //Holds the whole matrix plus enough slack to align its start
+    T *base;
+};
+
+template <typename T>
+void Graph<T>::allocate(int n)
+{
+    const int per_simd = SIMD_BYTES / sizeof(T);
+    size = n;
+    stride = (n + per_simd - 1) / per_simd * per_simd;
+    storage.assign((size_t)stride * n + per_simd, 0);
+    void *start = storage.data();
+    size_t space = storage.size() * sizeof(T);
+    base = static_cast<T *>(align(SIMD_BYTES, (size_t)stride * n * sizeof(T), start, space));
+}
+
+template <typename T>
+T Graph<T>::checked_weight(int weight)
+{
+    if ((long long)weight < (long long)numeric_limits<T>::min() || (long long)weight > (long long)numeric_limits<T>::max())
+        throw out_of_range("Weight " + to_string(weight) + " doesn't fit the matrix");
+    return weight;
+}
+
+template <typename T>
+Graph<T>::Graph(ifstream &my_file)
+{
+    INSTRUMENT_PHASE("build_matrix");
+    int n = 0;
+    my_file >> n;       //Size of graph is always the first int written in the file
+    if (n < 0)
+        throw out_of_range("Negative number of vertices in the graph file");
+    allocate(n);
+    int row, col, dist;
+    //Reading the edges from file written in this order: U V Distance.
+    //Parallel edges keep the lightest weight, as in the constructor from an edge list.
+    while (my_file >> row >> col >> dist)
+    {
+        if (row < 0 || row >= size || col < 0 || col >= size)
+            throw out_of_range("Edge " + to_string(row) + " " + to_string(col) + " names a vertex outside the graph");
+        T weight = checked_weight(dist);
+        T &w = at(row, col);
+        if (w == 0 || weight < w)
+            w = weight;
+    }
+    my_file.close();
+}
+template <typename T>
+Graph<T>::Graph(int n, const vector<EDGE> &edges)
+{
+    INSTRUMENT_PHASE("build_matrix");
+    allocate(n);
+    //Parallel edges keep the lightest weight, as they would in the sparse graph
+    for (size_t i = 0; i < edges.size(); i++)
+    {
+        if (edges[i].u < 0 || edges[i].u >= size || edges[i].v < 0 || edges[i].v >= size)
+            throw out_of_range("Edge " + to_string(edges[i].u) + " " + to_string(edges[i].v) + " names a vertex outside the graph");
+        T weight = checked_weight(edges[i].weight);
+        T &w = at(edges[i].u, edges[i].v);
+        if (w == 0 || weight < w)
+            w = weight;
+    }
+}
+template <typename T>
+void Graph<T>::print_graph()
+{
+    for (int i = 0; i < size; i++)
+    {
+        RowView<T> row = get_edges(i);
+        for (auto j = row.begin(); j != row.end(); j++)
+        {
+            cout << *j << "\t";
+        }
+        cout << endl;
+    }
+}
+
+//True if every weight fits the 16 bit matrix
+inline bool fits_16_bits(const vector<EDGE> &edges)
+{
+    for (size_t i = 0; i < edges.size(); i++)
+        if (edges[i].weight < 0 || edges[i].weight > numeric_limits<uint16_t>::max())
+            return false;
+    return true;
+}
+
+//Largest edge weight, 0 without edges
+inline int max_weight(const vector<EDGE> &edges)
+{
+    int largest = 0;
+    for (size_t i = 0; i < edges.size(); i++)
+        largest = max(largest, edges[i].weight);
+    return largest;
+}
+
+//Compressed sparse row graph from the graph library. Memory grows with the number of edges
+//instead of V x V, so sparse graphs with millions of vertices fit.
+typedef CsrGraph<int> SparseGraph;
+
+//Minimum spanning tree rooted at vertex 0, stored as the parent of each vertex and the weight
+//of the edge joining them. A path is rebuilt only when asked for, so storing or exporting
+//the tree is linear in the number of vertices.
+class SpanningTree
+{
+public:
+    SpanningTree() {}
+    SpanningTree(vector<int> p, vector<int> d) : parent(p), min_dist(d) {}
+    int get_size() const { return parent.size(); }
+    int get_parent(int v) const { return parent[v]; }
+    int get_weight(int v) const { return min_dist[v]; }
+    bool in_tree(int v) const { return min_dist[v] != INF_DIST; }
+    vector<int> path(int v);                  //Vertices from the root down to v, empty if v isn't connected to it
+    long long tree_cost();
+    bool export_csv(const string &file_name); //One "vertex,parent,weight" line per vertex
+    bool save(const string &file_name);       //Compact binary copy of parent and min_dist
+    bool load(const string &file_name);       //False, and empty, for a file that isn't a valid tree
+
+private:
+    vector<int> parent;   //-1 for the root and for vertices not connected to it
+    vector<int> min_dist; //Weight of the edge to the parent, INF_DIST if not connected
+};
+
+inline vector<int> SpanningTree::path(int v)
+{
+    vector<int> result;
+    if (!in_tree(v))
+        return result;
+    for (; v != -1; v = parent[v])
+        result.push_back(v);
+    reverse(result.begin(), result.end());
+    return result;
+}
+
+inline long long SpanningTree::tree_cost()
+{
+    long long cost = 0;
+    for (int v = 0; v < get_size(); v++)
+        if (in_tree(v))
+            cost += min_dist[v];
+    return cost;
+}
+
+inline bool SpanningTree::export_csv(const string &file_name)
+{
+    INSTRUMENT_PHASE("export");
+    CsvWriter out(file_name);
+    if (!out.is_open())
+        return false;
+    out.text("vertex,parent,weight\n");
+    for (int v = 0; v < get_size(); v++)
+    {
+        out.field(v);
+        out.text(",");
+        out.field(parent[v]);
+        out.text(",");
+        if (in_tree(v))
+            out.field(min_dist[v]);
+        else
+            out.text("inf");
+        out.text("\n");
+    }
+    return out.close();
+}
+
+//File layout: "MST1", vertex count, parent[size], min_dist[size]
+inline bool SpanningTree::save(const string &file_name)
+{
+    INSTRUMENT_PHASE("export");
+    ofstream out(file_name, ios::binary);
+    if (!out.is_open())
+        return false;
+    int size = parent.size();
+    out.write("MST1", 4);
+    out.write(reinterpret_cast<const char *>(&size), sizeof(int));
+    out.write(reinterpret_cast<const char *>(parent.data()), size * sizeof(int));
+    out.write(reinterpret_cast<const char *>(min_dist.data()), size * sizeof(int));
+    return out.good();
+}
+
+inline bool SpanningTree::load(const string &file_name)
+{
+    parent.clear();
+    min_dist.clear();
+    ifstream in(file_name, ios::binary | ios::ate);
+    long long length = in.tellg();
+    in.seekg(0);
+    char magic[4];
+    int size;
+    if (!in.read(magic, 4) || string(magic, 4) != "MST1")
+        return false;
+    if (!in.read(reinterpret_cast<char *>(&size), sizeof(int)) || size < 0)
+        return false;
+    //The file must hold exactly the two arrays its header announces
+    if (length != 4 + (long long)sizeof(int) + 2LL * size * (long long)sizeof(int))
+        return false;
+    vector<int> p(size), d(size);
+    in.read(reinterpret_cast<char *>(p.data()), size * sizeof(int));
+    in.read(reinterpret_cast<char *>(d.data()), size * sizeof(int));
+    if (in.fail() || !is_parent_forest(p))
+        return false;
+    //A vertex with a parent is in the tree, and so is its parent
+    for (int v = 0; v < size; v++)
+        if (p[v] >= 0 && (d[v] == INF_DIST || d[p[v]] == INF_DIST))
+            return false;
+    parent.swap(p);
+    min_dist.swap(d);
+    return true;
+}
+
+//Distances from the root, depths and subtree sizes of every vertex of a spanning forest, found
+//in one breadth first pass over the parent array. Binary lifting tables then answer the lowest
+//common ancestor and the cost of the tree path between any two vertices in O(log V).
+class TreeAnalytics
+{
+public:
+    TreeAnalytics(const SpanningTree &tree);
+    long long get_distance(int v) { return dist[v]; } //Cost of the path from v up to its root
+    int get_depth(int v) { return depth[v]; }
+    int get_subtree_size(int v) { return subtree[v]; }
+    int get_root(int v) { return root[v]; }
+    int lca(int u, int v);             //-1 if u and v are in different trees
+    long long path_cost(int u, int v); //-1 if u and v are in different trees
+
+private:
+    vector<long long> dist;
+    vector<int> depth, subtree, root;
+    vector<vector<int>> up; //up[k][v] is the 2^k-th ancestor of v, a root is its own ancestor
+};
+
+inline TreeAnalytics::TreeAnalytics(const SpanningTree &tree)
+{
+    INSTRUMENT_PHASE("tree_analytics");
+    int n = tree.get_size();
+    dist.assign(n, 0);
+    depth.assign(n, 0);
+    subtree.assign(n, 1);
+    root.resize(n);
+    up.assign(1, vector<int>(n));
+
+    //Children grouped by parent, then a queue seeded with every root gives a top down order
+    vector<int> first(n + 1, 0), children(n), order;
+    order.reserve(n);
+    for (int v = 0; v < n; v++)
+        if (tree.get_parent(v) >= 0)
+            first[tree.get_parent(v) + 1]++;
+    partial_sum(first.begin(), first.end(), first.begin());
+    vector<int> next(first.begin(), first.end() - 1);
+    for (int v = 0; v < n; v++)
+        if (tree.get_parent(v) >= 0)
+            children[next[tree.get_parent(v)]++] = v;
+        else
+        {
+            root[v] = up[0][v] = v;
+            order.push_back(v);
+        }
+    int max_depth = 0;
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        int u = order[i];
+        for (int j = first[u]; j < first[u + 1]; j++)
+        {
+            int v = children[j];
+            up[0][v] = u;
+            root[v] = root[u];
+            depth[v] = depth[u] + 1;
+            dist[v] = dist[u] + tree.get_weight(v);
+            max_depth = max(max_depth, depth[v]);
+            order.push_back(v);
+        }
+    }
+    for (int i = order.size() - 1; i >= 0; i--)
+        if (up[0][order[i]] != order[i])
+            subtree[up[0][order[i]]] += subtree[order[i]];
+
+    for (int k = 1; (1 << k) <= max_depth; k++)
+    {
+        up.push_back(vector<int>(n));
+        for (int v = 0; v < n; v++)
+            up[k][v] = up[k - 1][up[k - 1][v]];
+    }
+}
+
+inline int TreeAnalytics::lca(int u, int v)
+{
+    if (root[u] != root[v])
+        return -1;
+    if (depth[u] < depth[v])
+        swap(u, v);
+    for (int k = up.size() - 1; k >= 0; k--)
+        if (depth[u] - (1 << k) >= depth[v])
+            u = up[k][u];
+    if (u == v)
+        return u;
+    for (int k = up.size() - 1; k >= 0; k--)
+        if (up[k][u] != up[k][v])
+        {
+            u = up[k][u];
+            v = up[k][v];
+        }
+    return up[0][u];
+}
+
+inline long long TreeAnalytics::path_cost(int u, int v)
+{
+    int a = lca(u, v);
+    return (a < 0) ? -1 : dist[u] + dist[v] - 2 * dist[a];
+}
+
+//Prim's algorithm on the matrix with a heap, returns the tree without printing anything
+template <typename Queue = PriorityQueue<int>, typename T>
+SpanningTree prim_tree(Graph<T> &g)
+{
+    vector<int> min_dist; //To store the shortest edge for each node
+    vector<int> parent;   //To save the path with the least cost
+    prim_search<Queue>(g, 0, parent, min_dist);
+    return SpanningTree(parent, min_dist);
+}
+
+//Index of the smallest value of key[0 .. n) compared as unsigned, n > 0
+inline int argmin_unsigned(const unsigned *key, int n)
+{
+    int v = 0;
+    unsigned best = numeric_limits<unsigned>::max();
+#ifdef __AVX2__
+    //First pass finds the minimum 8 lanes at a time, the second one finds where it is
+    __m256i lanes = _mm256_set1_epi32(-1);
+    for (; v + 8 <= n; v += 8)
+        lanes = _mm256_min_epu32(lanes, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(key + v)));
+    unsigned mins[8];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(mins), lanes);
+    for (int i = 0; i < 8; i++)
+        best = min(best, mins[i]);
+    for (; v < n; v++)
+        best = min(best, key[v]);
+    __m256i target = _mm256_set1_epi32(best);
+    for (v = 0; v + 8 <= n; v += 8)
+    {
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(target, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(key + v)))));
+        if (mask)
+            return v + __builtin_ctz(mask);
+    }
+    for (; v < n; v++)
+        if (key[v] == best)
+            return v;
+    return 0;
+#else
+    int best_v = 0;
+    for (; v < n; v++)
+        if (key[v] < best)
+        {
+            best = key[v];
+            best_v = v;
+        }
+    return best_v;
+#endif
+}
+
+#ifdef __AVX2__
+//Loads 8 weights of an aligned matrix row as 32 bit lanes
+inline __m256i load_weights(const int *row) { return _mm256_load_si256(reinterpret_cast<const __m256i *>(row)); }
+inline __m256i load_weights(const uint16_t *row) { return _mm256_cvtepu16_epi32(_mm_load_si128(reinterpret_cast<const __m128i *>(row))); }
+#endif
+
+//Prim's algorithm for dense graphs, O(V^2) with no heap at all. Candidate edge weights live in a flat
+//array; each step picks the smallest with a linear scan and relaxes the new vertex's whole matrix row.
+//Both loops run 8 vertices at a time with AVX2 when compiled for it (-mavx2 or -march=native).
+//
+//key holds (weight - 1) of the best edge into each vertex, INF_DIST if there's none yet. A vertex
+//already in the tree gets key -1: no edge can improve on it (w - 1 >= 0 > -1), and as an unsigned
+//value it's the largest, so the scan for the minimum skips it without a separate visited check.
+//key and parent are as long as a padded matrix row, the padding starts out in the tree.
+template <typename T>
+SpanningTree prim_dense(Graph<T> &g)
+{
+    INSTRUMENT_PHASE("prim_dense");
+    int n = g.get_size(), stride = g.get_stride();
+    vector<int> min_dist(n, INF_DIST), parent(stride, -1);
+    if (n == 0)
+        return SpanningTree(parent, min_dist);
+    vector<int> key(stride, -1);
+    fill(key.begin(), key.begin() + n, INF_DIST);
+    key[0] = 0; //Picked first, its min_dist is 0
+
+    for (int step = 0; step < n; step++)
+    {
+        int u = argmin_unsigned(reinterpret_cast<const unsigned *>(key.data()), stride);
+        if (key[u] < 0 || key[u] == INF_DIST)
+            break; //Everything left is unreachable from the root
+        min_dist[u] = (u == 0) ? 0 : key[u] + 1;
+        key[u] = -1;
+        INSTRUMENT_ADD(EDGE_RELAXATIONS, n);
+
+        const T *row = g.row_data(u);
+        int v = 0;
+#ifdef __AVX2__
+        __m256i zero = _mm256_setzero_si256(), one = _mm256_set1_epi32(1), top = _mm256_set1_epi32(u);
+        for (; v < stride; v += 8)
+        {
+            __m256i w = load_weights(row + v);
+            __m256i k = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(key.data() + v));
+            __m256i w1 = _mm256_sub_epi32(w, one);
+            //w > 0 && w - 1 < k
+            __m256i better = _mm256_and_si256(_mm256_cmpgt_epi32(w, zero), _mm256_cmpgt_epi32(k, w1));
+            if (_mm256_testz_si256(better, better))
+                continue;
+            __m256i p = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(parent.data() + v));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(key.data() + v), _mm256_blendv_epi8(k, w1, better));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(parent.data() + v), _mm256_blendv_epi8(p, top, better));
+        }
+#endif
+        for (; v < n; v++)
+            if (row[v] > 0 && row[v] - 1 < key[v])
+            {
+                key[v] = row[v] - 1;
+                parent[v] = u;
+            }
+    }
+    parent.resize(n);
+    return SpanningTree(parent, min_dist);
+}
+
+//Builds the matrix with weights of type T and runs the dense kernel on it
+template <typename T>
+SpanningTree dense_tree(int n, const vector<EDGE> &edges)
+{
+    Graph<T> g(n, edges);
+    //g.print_graph();
+    return prim_dense(g);
+}
+
+//Prim's algorithm on a sparse graph. Each step scans only the edges of the new tree vertex
+//and updates the heap in O(log V), so the whole run is O(E log V). The 4-ary heap is the
+//default as most of the heap operations are decreases, which it does in fewer levels.
+//With small weights main picks the bucket queue instead. Any order but Input runs on a copy
+//with the vertices renumbered, the tree still uses the original numbers and is rooted at 0.
+template <typename Queue = PriorityQueue<int, QuaternaryHeap>>
+SpanningTree prim_sparse(SparseGraph &g, VertexOrder order = VertexOrder::Input)
+{
+    vector<int> min_dist;
+    vector<int> parent;
+    if (order == VertexOrder::Input)
+    {
+        prim_search<Queue>(g, 0, parent, min_dist);
+        return SpanningTree(parent, min_dist);
+    }
+    Renumbering r(g, order);
+    SparseGraph renumbered = r.apply<int>(g);
+    prim_search<Queue>(renumbered, r.to_new(0), parent, min_dist);
+    return SpanningTree(r.restore_ids(parent), r.restore(min_dist));
+}
+
+//Times sparse Prim with every priority queue that allows keys below the last one popped
+inline void benchmark_heaps(SparseGraph &g)
+{
+    const HeapPolicy policies[] = {HeapPolicy::Binary, HeapPolicy::Dary, HeapPolicy::Bucket, HeapPolicy::Fibonacci};
+    const char *names[] = {"binary", "dary", "bucket", "fibonacci"};
+    cout << "Vertices: " << g.get_size() << "\tEdges: " << g.edge_count() << "\n\n";
+    for (int p = 0; p < 4; p++)
+    {
+        SpanningTree tree;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        try
+        {
+            with_heap<int>(policies[p], [&](auto tag) { tree = prim_sparse<typename decltype(tag)::type>(g); });
+        }
+        catch (const length_error &)
+        {
+            cout << names[p] << "		edge weights too large\n";
+            continue;
+        }
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        cout << names[p] << "\t\t" << ms << " ms, cost of tree = " << tree.tree_cost() << "\n";
+    }
+
+    //And the 4-ary heap in every other vertex order
+    const VertexOrder orders[] = {VertexOrder::Bfs, VertexOrder::CuthillMcKee, VertexOrder::Degree};
+    const char *order_names[] = {"bfs", "rcm", "degree"};
+    cout << "\nVertex orders with the dary heap:\n";
+    for (int o = 0; o < 3; o++)
+    {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        Renumbering r(g, orders[o]);
+        SparseGraph renumbered = r.apply<int>(g);
+        chrono::steady_clock::time_point built = chrono::steady_clock::now();
+        SpanningTree tree = prim_sparse(renumbered);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - built).count();
+        cout << order_names[o] << "\t\t" << ms << " ms, cost of tree = " << tree.tree_cost() << ", "
+             << chrono::duration<double, milli>(built - start).count() << " ms to renumber\n";
+    }
+}
+
+//Disjoint "union find" sets with union by size and path halving
+class DisjointSet
+{
+public:
+    explicit DisjointSet(int n) : parent(n), treeSize(n, 1) { iota(parent.begin(), parent.end(), 0); }
+    int findSet(int v)
+    {
+        INSTRUMENT_COUNT(FIND_CALLS);
+        while (parent[v] != v)
+        {
+            parent[v] = parent[parent[v]];
+            v = parent[v];
+        }
+        return v;
+    }
+    //Find without path halving, safe to call from several threads while no set is being joined
+    int findRoot(int v) const
+    {
+        while (parent[v] != v)
+            v = parent[v];
+        return v;
+    }
+    //Joins the sets of a and b, false if they were already the same set
+    bool unionSets(int a, int b)
+    {
+        INSTRUMENT_COUNT(UNION_CALLS);
+        a = findSet(a);
+        b = findSet(b);
+        if (a == b)
+            return false;
+        if (treeSize[a] < treeSize[b])
+            swap(a, b);
+        parent[b] = a;
+        treeSize[a] += treeSize[b];
+        return true;
+    }
+
+private:
+    vector<int> parent, treeSize;
+};
+
+inline unsigned thread_count(unsigned threads) { return threads ? threads : max(1u, thread::hardware_concurrency()); }
+
+//Roots the forest made of the MST edges at vertex 0, giving the same parent/min_dist result as Prim.
+//Vertices outside the component of 0 are left out of the tree, as Prim never reaches them.
+inline SpanningTree tree_from_edges(int n, const vector<EDGE> &mst)
+{
+    vector<int> min_dist(n, INF_DIST), parent(n, -1);
+    if (n == 0)
+        return SpanningTree(parent, min_dist);
+    vector<EDGE> both;
+    for (size_t i = 0; i < mst.size(); i++)
+    {
+        both.push_back(mst[i]);
+        both.push_back({mst[i].v, mst[i].u, mst[i].weight});
+    }
+    SparseGraph tree(n, both);
+    vector<int> queue(1, 0);
+    min_dist[0] = 0;
+    for (size_t i = 0; i < queue.size(); i++)
+    {
+        int u = queue[i];
+        for (size_t e = tree.begin(u); e < tree.end(u); e++)
+        {
+            int v = tree.target(e);
+            if (v != 0 && parent[v] < 0)
+            {
+                parent[v] = u;
+                min_dist[v] = tree.weight(e);
+                queue.push_back(v);
+            }
+        }
+    }
+    return SpanningTree(parent, min_dist);
+}
+
+inline bool lighter(const EDGE &a, const EDGE &b) { return a.weight < b.weight; }
+
+//Sorts chunks of the edges on separate threads, then merges neighbouring chunks in parallel rounds
+inline void parallel_sort(vector<EDGE> &edges, unsigned threads)
+{
+    threads = min<size_t>(thread_count(threads), edges.size() / MIN_EDGES_PER_THREAD + 1);
+    vector<size_t> bounds(threads + 1);
+    for (unsigned t = 0; t <= threads; t++)
+        bounds[t] = edges.size() / threads * t;
+    bounds[threads] = edges.size();
+
+    vector<thread> workers;
+    for (unsigned t = 0; t < threads; t++)
+        workers.emplace_back([&edges, &bounds, t]() { sort(edges.begin() + bounds[t], edges.begin() + bounds[t + 1], lighter); });
+    for (unsigned t = 0; t < workers.size(); t++)
+        workers[t].join();
+
+    for (unsigned width = 1; width < threads; width *= 2)
+    {
+        workers.clear();
+        for (unsigned t = 0; t + width < threads; t += 2 * width)
+        {
+            size_t first = bounds[t], middle = bounds[t + width], last = bounds[min(t + 2 * width, threads)];
+            workers.emplace_back([&edges, first, middle, last]() { inplace_merge(edges.begin() + first, edges.begin() + middle, edges.begin() + last, lighter); });
+        }
+        for (unsigned t = 0; t < workers.size(); t++)
+            workers[t].join();
+    }
+}
+
+//Kruskal's algorithm: take edges from lightest to heaviest, keeping those that join two trees
+inline SpanningTree kruskal(int n, const vector<EDGE> &edges, unsigned threads = 0)
+{
+    INSTRUMENT_PHASE("kruskal");
+    vector<EDGE> sorted;
+    sorted.reserve(edges.size());
+    for (size_t i = 0; i < edges.size(); i++)
+        if (edges[i].weight >= 0 && edges[i].u != edges[i].v)
+            sorted.push_back(edges[i]);
+    parallel_sort(sorted, threads);
+
+    DisjointSet sets(n);
+    vector<EDGE> mst;
+    for (size_t i = 0; i < sorted.size() && mst.size() + 1 < (size_t)n; i++)
+        if (sets.unionSets(sorted[i].u, sorted[i].v))
+            mst.push_back(sorted[i]);
+    return tree_from_edges(n, mst);
+}
+
+//Runs work(first, last) over [0, count) split into one range per thread
+template <typename Work>
+void parallel_for(size_t count, unsigned threads, Work work)
+{
+    threads = min<size_t>(threads, count / MIN_EDGES_PER_THREAD + 1);
+    vector<thread> workers;
+    for (unsigned t = 1; t < threads; t++)
+        workers.emplace_back(work, count / threads * t, (t + 1 == threads) ? count : count / threads * (t + 1));
+    work(0, (threads > 1) ? count / threads : count);
+    for (unsigned t = 0; t < workers.size(); t++)
+        workers[t].join();
+}
+
+//Boruvka's algorithm: every round each component picks its lightest outgoing edge, and all of them
+//are added at once, so the number of components at least halves per round. The edge scan of a round
+//is split across threads, which publish each component's best edge with an atomic minimum.
+inline SpanningTree boruvka(int n, const vector<EDGE> &edges, unsigned threads = 0)
+{
+    INSTRUMENT_PHASE("boruvka");
+    //Edge indices have to fit in the low half of a key
+    if (edges.size() > 0xFFFFFFFFull)
+        return kruskal(n, edges, threads);
+    threads = thread_count(threads);
+    const unsigned long long NONE = numeric_limits<unsigned long long>::max();
+    //Key of an edge: weight in the high half, index in the low half, so ties are broken the same way everywhere
+    vector<atomic<unsigned long long>> best(n);
+    vector<int> comp(n);
+    iota(comp.begin(), comp.end(), 0);
+    DisjointSet sets(n);
+    vector<EDGE> mst;
+
+    for (bool merged = true; merged;)
+    {
+        for (int v = 0; v < n; v++)
+            best[v].store(NONE, memory_order_relaxed);
+        parallel_for(edges.size(), threads, [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; i++)
+            {
+                int cu = comp[edges[i].u], cv = comp[edges[i].v];
+                if (cu == cv || edges[i].weight < 0)
+                    continue;
+                unsigned long long key = (unsigned long long)edges[i].weight << 32 | i;
+                for (int c : {cu, cv})
+                {
+                    unsigned long long old = best[c].load(memory_order_relaxed);
+                    while (key < old && !best[c].compare_exchange_weak(old, key, memory_order_relaxed))
+                        ;
+                }
+            }
+        });
+
+        merged = false;
+        for (int c = 0; c < n; c++)
+        {
+            unsigned long long key = best[c].load(memory_order_relaxed);
+            if (key == NONE)
+                continue;
+            const EDGE &e = edges[key & 0xFFFFFFFFull];
+            if (sets.unionSets(e.u, e.v))
+            {
+                mst.push_back(e);
+                merged = true;
+            }
+        }
+        parallel_for(n, threads, [&](size_t first, size_t last) {
+            for (size_t v = first; v < last; v++)
+                comp[v] = sets.findRoot(v);
+        });
+    }
+    return tree_from_edges(n, mst);
+}
+
+//Link-cut tree: a forest whose nodes each carry a weight, answering "heaviest node on the path
+//between u and v" and joining or splitting trees in O(log n) amortized. Each tree is stored as
+//preferred paths kept in splay trees ordered by depth, with a lazy flag to reverse a path when
+//the root of its tree changes.
+class LinkCutTree
+{
+public:
+    int add_node(int weight)
+    {
+        t.push_back({{-1, -1}, -1, false, weight, (int)t.size()});
+        return t.size() - 1;
+    }
+    int weight(int x) { return t[x].weight; }
+    void set_weight(int x, int weight)
+    {
+        access(x);
+        t[x].weight = weight;
+        pull(x);
+    }
+    bool connected(int u, int v) { return u == v || find_root(u) == find_root(v); }
+    //Joins the trees of u and v with u as a child of v, they must not be connected yet
+    void link(int u, int v)
+    {
+        make_root(u);
+        t[u].parent = v;
+    }
+    //Removes the edge between neighbours u and v
+    void cut(int u, int v)
+    {
+        make_root(u);
+        access(v);
+        t[v].ch[0] = t[u].parent = -1;
+        pull(v);
+    }
+    //Node with the largest weight on the path from u to v, they must be connected
+    int path_max(int u, int v)
+    {
+        make_root(u);
+        access(v);
+        return t[v].best;
+    }
+
+private:
+    typedef struct LCT_NODE
+    {
+        int ch[2];
+        int parent;    //Parent in the splay tree, or path parent for the root of a splay tree
+        bool reversed; //The children of this subtree still have to be swapped
+        int weight;
+        int best;      //Node with the largest weight in this splay subtree
+    } LCT_NODE;
+
+    bool is_root(int x)
+    {
+        int p = t[x].parent;
+        return p < 0 || (t[p].ch[0] != x && t[p].ch[1] != x);
+    }
+    void pull(int x)
+    {
+        t[x].best = x;
+        for (int c : t[x].ch)
+            if (c >= 0 && t[t[c].best].weight > t[t[x].best].weight)
+                t[x].best = t[c].best;
+    }
+    void push(int x)
+    {
+        if (!t[x].reversed)
+            return;
+        swap(t[x].ch[0], t[x].ch[1]);
+        for (int c : t[x].ch)
+            if (c >= 0)
+                t[c].reversed = !t[c].reversed;
+        t[x].reversed = false;
+    }
+    void rotate(int x)
+    {
+        int p = t[x].parent, g = t[p].parent;
+        int dir = (t[p].ch[1] == x);
+        if (!is_root(p))
+            t[g].ch[t[g].ch[1] == p] = x;
+        t[x].parent = g;
+        t[p].ch[dir] = t[x].ch[!dir];
+        if (t[x].ch[!dir] >= 0)
+            t[t[x].ch[!dir]].parent = p;
+        t[x].ch[!dir] = p;
+        t[p].parent = x;
+        pull(p);
+        pull(x);
+    }
+    void splay(int x)
+    {
+        //Pending reversals are pushed down from the top of the splay tree first
+        path.clear();
+        for (int y = x;; y = t[y].parent)
+        {
+            path.push_back(y);
+            if (is_root(y))
+                break;
+        }
+        for (int i = path.size() - 1; i >= 0; i--)
+            push(path[i]);
+        while (!is_root(x))
+        {
+            int p = t[x].parent, g = t[p].parent;
+            if (!is_root(p))
+                rotate(((t[g].ch[1] == p) == (t[p].ch[1] == x)) ? p : x);
+            rotate(x);
+        }
+    }
+    //Makes the path from the root of x's tree down to x preferred, with x at the top of its splay tree
+    void access(int x)
+    {
+        for (int last = -1, y = x; y >= 0; last = y, y = t[y].parent)
+        {
+            splay(y);
+            t[y].ch[1] = last;
+            pull(y);
+        }
+        splay(x);
+    }
+    void make_root(int x)
+    {
+        access(x);
+        t[x].reversed = !t[x].reversed;
+    }
+    int find_root(int x)
+    {
+        access(x);
+        for (push(x); t[x].ch[0] >= 0; push(x))
+            x = t[x].ch[0];
+        splay(x);
+        return x;
+    }
+
+    vector<LCT_NODE> t;
+    vector<int> path;
+};
+
+//Minimum spanning forest kept up to date as edges are added, removed or re-weighted, instead of
+//rerunning the whole algorithm. Every tree edge is a node of a link-cut tree between its endpoints,
+//so a new edge that closes a cycle finds the heaviest edge on that cycle in O(log V), and replaces
+//it if lighter (cycle property). When a tree edge goes, the smaller of the two halves is walked and
+//the lightest edge leaving it reconnects them (cut property), so deletions cost the smaller half only.
+class DynamicMST
+{
+public:
+    //Starts from an MST of the edges (e.g. the one from prim_algo). Parallel edges keep the lightest,
+    //weights <= 0 mean no edge as in the matrix.
+    DynamicMST(const SpanningTree &tree, const vector<EDGE> &edges);
+    //Inserts the edge u-v or changes its weight, a weight <= 0 removes it
+    void set_edge(int u, int v, int w);
+    void remove_edge(int u, int v);
+    long long tree_cost() { return cost; } //Total weight of the spanning forest
+    SpanningTree get_tree();               //Current tree rooted at vertex 0, as prim_algo returns it
+
+private:
+    typedef struct EDGE_STATE
+    {
+        int weight;
+        int node; //Link-cut tree node while the edge is in the tree, -1 otherwise
+    } EDGE_STATE;
+    static long long key(int u, int v) { return (long long)min(u, v) << 32 | max(u, v); }
+    void insert(int u, int v, int w);
+    void link(int u, int v, EDGE_STATE &e);
+    void cut(int u, int v, EDGE_STATE &e);
+    void reconnect(int u, int v);
+
+    int size;
+    long long cost = 0;
+    LinkCutTree lct; //Nodes 0 .. size - 1 are the vertices, the rest are tree edges
+    unordered_map<long long, EDGE_STATE> edges;
+    vector<unordered_set<int>> nbrs;      //All edges of each vertex
+    vector<unordered_set<int>> tree_nbrs; //Tree edges of each vertex
+    vector<pair<int, int>> node_edge;     //Endpoints of the edge held by each link-cut tree node
+    vector<int> free_nodes;
+    vector<int> side;                     //Which half a vertex was found in by reconnect, by stamp
+    int stamp = 0;
+};
+
+inline DynamicMST::DynamicMST(const SpanningTree &tree, const vector<EDGE> &graph_edges)
+    : size(tree.get_size()), nbrs(size), tree_nbrs(size), node_edge(size), side(size, 0)
+{
+    for (int v = 0; v < size; v++)
+        lct.add_node(numeric_limits<int>::min()); //Vertices never win a path maximum
+    for (size_t i = 0; i < graph_edges.size(); i++)
+    {
+        const EDGE &e = graph_edges[i];
+        if (e.u == e.v || e.weight <= 0)
+            continue;
+        auto found = edges.find(key(e.u, e.v));
+        if (found == edges.end())
+        {
+            edges[key(e.u, e.v)] = {e.weight, -1};
+            nbrs[e.u].insert(e.v);
+            nbrs[e.v].insert(e.u);
+        }
+        else
+            found->second.weight = min(found->second.weight, e.weight);
+    }
+    //The given tree goes in as it is, the remaining edges only fill in other components
+    for (int v = 0; v < size; v++)
+    {
+        auto found = (tree.get_parent(v) >= 0) ? edges.find(key(v, tree.get_parent(v))) : edges.end();
+        if (found != edges.end())
+            link(v, tree.get_parent(v), found->second);
+    }
+    vector<pair<long long, int>> rest;
+    for (auto &e : edges)
+        if (e.second.node < 0)
+            rest.push_back({e.first, e.second.weight});
+    for (size_t i = 0; i < rest.size(); i++)
+    {
+        int u = rest[i].first >> 32, v = rest[i].first & 0xFFFFFFFF;
+        edges.erase(rest[i].first);
+        insert(u, v, rest[i].second);
+    }
+}
+
+inline void DynamicMST::link(int u, int v, EDGE_STATE &e)
+{
+    if (free_nodes.empty())
+    {
+        e.node = lct.add_node(e.weight);
+        node_edge.push_back({u, v});
+    }
+    else
+    {
+        e.node = free_nodes.back();
+        free_nodes.pop_back();
+        lct.set_weight(e.node, e.weight);
+        node_edge[e.node] = {u, v};
+    }
+    lct.link(u, e.node);
+    lct.link(e.node, v);
+    tree_nbrs[u].insert(v);
+    tree_nbrs[v].insert(u);
+    cost += e.weight;
+}
+
+inline void DynamicMST::cut(int u, int v, EDGE_STATE &e)
+{
+    lct.cut(u, e.node);
+    lct.cut(e.node, v);
+    free_nodes.push_back(e.node);
+    e.node = -1;
+    tree_nbrs[u].erase(v);
+    tree_nbrs[v].erase(u);
+    cost -= e.weight;
+}
+
+//Adds an edge that isn't in the graph yet
+inline void DynamicMST::insert(int u, int v, int w)
+{
+    EDGE_STATE &e = edges[key(u, v)];
+    e = {w, -1};
+    nbrs[u].insert(v);
+    nbrs[v].insert(u);
+    if (!lct.connected(u, v))
+    {
+        link(u, v, e);
+        return;
+    }
+    //The new edge closes a cycle, it replaces the heaviest edge on it if lighter
+    int heaviest = lct.path_max(u, v);
+    if (lct.weight(heaviest) <= w)
+        return;
+    pair<int, int> old = node_edge[heaviest];
+    cut(old.first, old.second, edges[key(old.first, old.second)]);
+    link(u, v, e);
+}
+
+//u and v were just split by removing the tree edge between them. Walks both halves one vertex at a
+//time until the smaller one is exhausted, then joins the halves with the lightest edge leaving it.
+inline void DynamicMST::reconnect(int u, int v)
+{
+    stamp += 2;
+    const int stamp_of[2] = {stamp - 1, stamp};
+    vector<int> queue[2] = {{u}, {v}};
+    side[u] = stamp_of[0];
+    side[v] = stamp_of[1];
+    size_t next[2] = {0, 0};
+    int small = -1;
+    while (small < 0)
+        for (int s = 0; s < 2 && small < 0; s++)
+        {
+            if (next[s] == queue[s].size())
+            {
+                small = s;
+                break;
+            }
+            int x = queue[s][next[s]++];
+            for (int y : tree_nbrs[x])
+                if (side[y] != stamp_of[s])
+                {
+                    side[y] = stamp_of[s];
+                    queue[s].push_back(y);
+                }
+        }
+
+    //Any other edge of the small half must lead to the other half, as the forest spans every edge
+    int best_u = -1, best_v = -1, best_w = INF_DIST;
+    for (int x : queue[small])
+        for (int y : nbrs[x])
+            if (side[y] != stamp_of[small])
+            {
+                int w = edges[key(x, y)].weight;
+                if (w < best_w)
+                {
+                    best_w = w;
+                    best_u = x;
+                    best_v = y;
+                }
+            }
+    if (best_u >= 0)
+        link(best_u, best_v, edges[key(best_u, best_v)]);
+}
+
+inline void DynamicMST::remove_edge(int u, int v)
+{
+    auto found = edges.find(key(u, v));
+    if (found == edges.end())
+        return;
+    bool in_tree = found->second.node >= 0;
+    if (in_tree)
+        cut(u, v, found->second);
+    edges.erase(found);
+    nbrs[u].erase(v);
+    nbrs[v].erase(u);
+    if (in_tree)
+        reconnect(u, v);
+}
+
+inline void DynamicMST::set_edge(int u, int v, int w)
+{
+    if (u < 0 || v < 0 || u >= size || v >= size || u == v)
+        return;
+    if (w <= 0)
+    {
+        remove_edge(u, v);
+        return;
+    }
+    auto found = edges.find(key(u, v));
+    if (found == edges.end())
+    {
+        insert(u, v, w);
+        return;
+    }
+    EDGE_STATE &e = found->second;
+    if (e.node >= 0 && w <= e.weight)
+    {
+        //A lighter tree edge stays in the tree
+        lct.set_weight(e.node, w);
+        cost += w - e.weight;
+        e.weight = w;
+    }
+    else if (e.node >= 0)
+    {
+        //A heavier tree edge competes with every other edge across the cut it leaves
+        cut(u, v, e);
+        e.weight = w;
+        reconnect(u, v);
+    }
+    else if (w < e.weight)
+    {
+        edges.erase(found);
+        insert(u, v, w);
+    }
+    else
+        e.weight = w; //A heavier non-tree edge can't enter the tree
+}
+
+inline SpanningTree DynamicMST::get_tree()
+{
+    vector<EDGE> mst;
+    for (auto &e : edges)
+        if (e.second.node >= 0)
+            mst.push_back({(int)(e.first >> 32), (int)(e.first & 0xFFFFFFFF), e.second.weight});
+    return tree_from_edges(size, mst);
+}
+
+//Prints the path from every vertex up to the root and the cost of reaching it
+inline void print_tree(SpanningTree &tree)
+{
+    int n = tree.get_size();
+    TreeAnalytics analytics(tree);
+
+    cout << "Printing out the path to each vertex:\n\n";
+    for (int i = 0; i < n; i++)
+    {
+        vector<int> path = tree.path(i);
+        if (path.empty())
+        {
+            cout << i << " isn't connected to the tree\n\n";
+            continue;
+        }
+        cout << i;
+        for (int j = (int)path.size() - 2; j >= 0; j--)
+            cout << "<-" << path[j];
+        cout << "\n\n";
+    }
+    cout << "Vertex\t\tCost to this node\n\n";
+    for (int node = 0; node < n; node++)
+        cout << node << "\t\t" << analytics.get_distance(node) << "\n";
+    cout << endl << "Cost of tree = " << tree.tree_cost() << endl;
+}
+
+template <typename T>
+void prim_algo(Graph<T> &g)
+{
+    SpanningTree tree = prim_tree(g);
+    print_tree(tree);
+}
+
+#endif